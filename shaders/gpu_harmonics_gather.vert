@@ -0,0 +1,12 @@
+#version 450 core
+#extension GL_GOOGLE_include_directive : require
+
+#include "gpu_harmonics.glsl"
+
+layout(location = 1) in uint voxel;
+
+
+void main() {
+    /* The voxel index is gathered, one per visible point */
+    emitVoxel(voxel);
+}
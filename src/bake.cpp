@@ -0,0 +1,167 @@
+/**
+ * bake.cpp
+ *
+ *    Created on: Jan 15, 2025
+ *   Last Update: Jan 15, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  atomix-bake: runs the CloudManager pipeline on a .cloud config without Qt widgets or
+ *  Vulkan, to pre-bake clouds into a cache directory or file, and to time the bake stages.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include "filehandler.hpp"
+#include "cloudmanager.hpp"
+
+
+bool isDebug;
+bool isMacOS;
+bool isProfiling;
+bool isTesting;
+
+
+int main(int argc, char* argv[]) {
+    // Application
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("atomix-bake");
+    app.setOrganizationName("nolnoch");
+    app.setApplicationVersion(QT_VERSION_STR);
+
+    // CLI Parsing
+    QCommandLineParser qParser;
+    qParser.setApplicationDescription(QCoreApplication::translate("bake", "Bake an atomix cloud config without a display, and report the time of each stage."));
+    QCommandLineOption cliVerbose("verbose", QCoreApplication::translate("bake", "ALL debug and information messages"));
+    QCommandLineOption cliOutput({ "o", "output" }, QCoreApplication::translate("bake", "write the baked cloud to this file, in the cloud cache format"), "file");
+    QCommandLineOption cliCacheDir("cache-dir", QCoreApplication::translate("bake", "load from and store to this cloud cache directory; a hit is timed as the bake (default: none, always bake)"), "directory");
+    QCommandLineOption cliThreads("threads", QCoreApplication::translate("bake", "threads used to bake (default: all cores but one)"), "count", "0");
+    QCommandLineOption cliLayerGrain("layer-grain", QCoreApplication::translate("bake", "minimum layers per parallel task (default: 1)"), "layers", "1");
+    QCommandLineOption cliBakeMode("bake-mode", QCoreApplication::translate("bake", "bake strategy: per-voxel, tables, or ring-tables (default: ring-tables)"), "mode", "ring-tables");
+    QCommandLineOption cliToleranceIndex("tolerance-index", QCoreApplication::translate("bake", "build the PDV-sorted index used for fast tolerance re-culls"));
+    QCommandLineOption cliHugePages("huge-pages", QCoreApplication::translate("bake", "advise grid buffers as transparent huge pages (Linux only)"));
+    QCommandLineOption cliRepeat("repeat", QCoreApplication::translate("bake", "bake this many times from scratch, and report the mean stage times (default: 1)"), "count", "1");
+    qParser.addHelpOption();
+    qParser.addVersionOption();
+    qParser.addPositionalArgument("config", QCoreApplication::translate("bake", "the .cloud config file to bake"));
+    qParser.addOption(cliVerbose);
+    qParser.addOption(cliOutput);
+    qParser.addOption(cliCacheDir);
+    qParser.addOption(cliThreads);
+    qParser.addOption(cliLayerGrain);
+    qParser.addOption(cliBakeMode);
+    qParser.addOption(cliToleranceIndex);
+    qParser.addOption(cliHugePages);
+    qParser.addOption(cliRepeat);
+    qParser.process(app);
+
+    if (qParser.positionalArguments().size() != 1) {
+        qParser.showHelp(1);
+    }
+    isDebug = qParser.isSet(cliVerbose);
+
+    const QStringList modes = { "per-voxel", "tables", "ring-tables" };
+    qsizetype mode = modes.indexOf(qParser.value(cliBakeMode).toLower());
+    if (mode < 0) {
+        std::cerr << "Unknown bake mode \"" << qParser.value(cliBakeMode).toStdString() << "\"" << std::endl;
+        return 1;
+    }
+    int repeat = std::max(1, qParser.value(cliRepeat).toInt());
+    bufferHugePages = qParser.isSet(cliHugePages);
+    CloudManager::setBakeThreads(qParser.value(cliThreads).toInt());
+    CloudManager::setLayerGrain(qParser.value(cliLayerGrain).toInt());
+
+    // Config
+    QString cfgPath = qParser.positionalArguments().first();
+    if (!QFileInfo::exists(cfgPath)) {
+        std::cerr << "No such config file: " << cfgPath.toStdString() << std::endl;
+        return 1;
+    }
+    FileHandler fileHandler;
+    harmap recipes;
+    SuperConfig loaded = fileHandler.loadConfigFile(cfgPath, &recipes);
+    if (!std::holds_alternative<AtomixCloudConfig>(loaded) || recipes.empty()) {
+        std::cerr << "Not a cloud config with recipes: " << cfgPath.toStdString() << std::endl;
+        return 1;
+    }
+    AtomixCloudConfig cfg = std::get<AtomixCloudConfig>(loaded);
+
+    std::cout << "Config:      " << cfgPath.toStdString() << "\n";
+    std::cout << "Grid:        resolution " << cfg.cloudResolution << ", divisor " << cfg.cloudLayDivisor << ", tolerance " << cfg.cloudTolerance << "\n";
+    std::cout << "Threads:     " << CloudManager::getBakeThreads() << ", layer grain " << qParser.value(cliLayerGrain).toInt() << ", " << modes[mode].toStdString() << std::endl;
+
+    // Bake, each run in a fresh manager so no grid, table, or buffer is reused
+    std::unique_ptr<CloudManager> cloudManager;
+    std::array<double, 6> stageSums = {};
+    double totalSum = 0.0;
+    double totalMin = 0.0;
+    for (int run = 0; run < repeat; run++) {
+        cloudManager = std::make_unique<CloudManager>();
+        cloudManager->setProgressive(false);
+        cloudManager->setBakeMode(static_cast<BakeMode>(mode));
+        cloudManager->setToleranceIndex(qParser.isSet(cliToleranceIndex));
+        if (qParser.isSet(cliCacheDir)) {
+            cloudManager->setCacheDir(qParser.value(cliCacheDir).toStdString());
+        }
+
+        auto begin = steady_clock::now();
+        cloudManager->receiveCloudMapAndConfig(&cfg, &recipes, true);
+        double total = std::chrono::duration<double, std::milli>(steady_clock::now() - begin).count();
+
+        std::array<double, 6> stages = cloudManager->getStageTimes();
+        for (size_t i = 0; i < stages.size(); i++) {
+            stageSums[i] += stages[i];
+        }
+        totalSum += total;
+        totalMin = (run) ? std::min(totalMin, total) : total;
+        if (repeat > 1) {
+            std::cout << "Run " << std::setw(3) << (run + 1) << ":     " << std::setprecision(2) << std::fixed << std::setw(9) << total << " ms" << std::endl;
+        }
+    }
+
+    // Summary
+    std::cout << "Voxels:      " << cloudManager->getVoxelCount() << " (" << cloudManager->getVisibleCount() << " above tolerance)\n\n";
+    std::cout << "Mean stage times over " << repeat << " run(s):\n";
+    for (size_t i = 0; i < stageSums.size(); i++) {
+        if (stageSums[i]) {
+            std::cout << cloudManager->getStageLabels()[i] << std::setprecision(2) << std::fixed << std::setw(9) << (stageSums[i] / repeat) << " ms\n";
+        }
+    }
+    std::cout << "Total:            " << std::setprecision(2) << std::fixed << std::setw(9) << (totalSum / repeat) << " ms";
+    if (repeat > 1) {
+        std::cout << " (min " << totalMin << " ms)";
+    }
+    std::cout << std::endl;
+
+    if (qParser.isSet(cliOutput)) {
+        std::string outPath = qParser.value(cliOutput).toStdString();
+        if (!cloudManager->exportCloud(outPath)) {
+            std::cerr << "Failed to write " << outPath << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote:       " << outPath << std::endl;
+    }
+
+    return 0;
+}
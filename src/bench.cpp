@@ -0,0 +1,327 @@
+/**
+ * bench.cpp
+ *
+ *    Created on: Jan 16, 2025
+ *   Last Update: Jan 16, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  atomix-bench: times every stage of the cloud pipeline over the shipped .cloud configs and
+ *  synthetic shallow/deep x narrow/wide sets, across thread counts, and reports JSON with the
+ *  median and p95 time, voxel throughput, and peak RSS of each, as a baseline for optimizations.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include "filehandler.hpp"
+#include "cloudmanager.hpp"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#else
+#include <sys/resource.h>
+#endif
+
+
+bool isDebug;
+bool isMacOS;
+bool isProfiling;
+bool isTesting;
+
+
+/* One cloud to benchmark */
+struct BenchCase {
+    std::string name;
+    std::string source;         // Config file, or "synthetic"
+    AtomixCloudConfig cfg;
+    harmap recipes;
+};
+
+/* Stages reported, as indices into CloudManager::getStageTimes(); recullTolerance is timed separately */
+const std::array<std::pair<const char *, int>, 4> BENCH_STAGES = { { { "create", 0 }, { "bake", 1 }, { "cullTolerance", 4 }, { "cullSlider", 5 } } };
+
+
+/**
+ * @brief Reset the peak resident set size, where the platform allows it.
+ *
+ * @details
+ * Only Linux can reset the peak (through clear_refs); elsewhere, peakRss() stays the
+ * process-wide peak, so a case reports the largest peak of all cases up to it.
+ */
+static void resetPeakRss() {
+#ifdef __linux__
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+/**
+ * @brief Get the peak resident set size since the last resetPeakRss(), in bytes.
+ */
+static uint64_t peakRss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? uint64_t(counters.PeakWorkingSetSize) : 0;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) {
+            return std::stoull(line.substr(6)) << 10;
+        }
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return uint64_t(usage.ru_maxrss);   // Bytes on macOS
+#endif
+}
+
+/**
+ * @brief Summarize run times as their median and p95 (nearest rank), and voxels per second at the median.
+ *
+ * @param times The time of each run in milliseconds; sorted in place.
+ * @param voxels The voxel count of the grid.
+ * @return The summary as a JSON object.
+ */
+static QJsonObject summarize(std::vector<double> &times, uint64_t voxels) {
+    std::sort(times.begin(), times.end());
+    size_t n = times.size();
+    double median = (n & 1) ? times[n >> 1] : 0.5 * (times[(n >> 1) - 1] + times[n >> 1]);
+    double p95 = times[std::min(n - 1, size_t(std::ceil(0.95 * double(n))) - 1)];
+
+    QJsonObject stats;
+    stats["medianMs"] = median;
+    stats["p95Ms"] = p95;
+    stats["voxelsPerSec"] = (median > 0.0) ? (double(voxels) * 1000.0 / median) : 0.0;
+    return stats;
+}
+
+/**
+ * @brief Bake one case `runs` times at one thread count, each in a fresh manager.
+ *
+ * @param bc The case.
+ * @param threads The bake thread count.
+ * @param runs The number of runs.
+ * @param toleranceIndex True to keep the PDV-sorted index for tolerance re-culls.
+ * @param[out] voxels The voxel count of the grid.
+ * @param[out] visible The count of voxels above tolerance.
+ * @return The result as a JSON object.
+ */
+static QJsonObject benchCase(BenchCase &bc, int threads, int runs, bool toleranceIndex, uint64_t &voxels, uint64_t &visible) {
+    CloudManager::setBakeThreads(threads);
+    std::array<std::vector<double>, BENCH_STAGES.size()> stageTimes;
+    std::vector<double> recullTimes;
+    std::vector<double> totals;
+
+    // A raised tolerance never widens the radius, so this only re-culls the bake
+    AtomixCloudConfig recullCfg = bc.cfg;
+    recullCfg.cloudTolerance *= 2.0;
+
+    resetPeakRss();
+    for (int run = 0; run < runs; run++) {
+        auto cloudManager = std::make_unique<CloudManager>();
+        cloudManager->setProgressive(false);
+        cloudManager->setToleranceIndex(toleranceIndex);
+
+        auto begin = steady_clock::now();
+        cloudManager->receiveCloudMapAndConfig(&bc.cfg, &bc.recipes, true);
+        totals.push_back(std::chrono::duration<double, std::milli>(steady_clock::now() - begin).count());
+
+        for (size_t s = 0; s < BENCH_STAGES.size(); s++) {
+            stageTimes[s].push_back(cloudManager->getStageTimes()[BENCH_STAGES[s].second]);
+        }
+        voxels = cloudManager->getVoxelCount();
+        visible = cloudManager->getVisibleCount();
+
+        cloudManager->receiveCloudMapAndConfig(&recullCfg, &bc.recipes, true);
+        recullTimes.push_back(cloudManager->getStageTimes()[4]);
+    }
+
+    QJsonObject stages;
+    for (size_t s = 0; s < BENCH_STAGES.size(); s++) {
+        stages[BENCH_STAGES[s].first] = summarize(stageTimes[s], voxels);
+    }
+    stages["recullTolerance"] = summarize(recullTimes, voxels);
+    stages["total"] = summarize(totals, voxels);
+
+    QJsonObject result;
+    result["threads"] = threads;
+    result["peakRssBytes"] = qint64(peakRss());
+    result["stages"] = stages;
+    return result;
+}
+
+
+int main(int argc, char* argv[]) {
+    // Application
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("atomix-bench");
+    app.setOrganizationName("nolnoch");
+    app.setApplicationVersion(QT_VERSION_STR);
+
+    // CLI Parsing
+    QCommandLineParser qParser;
+    qParser.setApplicationDescription(QCoreApplication::translate("bench", "Benchmark the cloud pipeline over the shipped configs and synthetic recipe sets, and report JSON."));
+    QCommandLineOption cliConfigs({ "c", "configs" }, QCoreApplication::translate("bench", "directory of .cloud configs to benchmark (default: ./configs)"), "directory", "configs");
+    QCommandLineOption cliOutput({ "o", "output" }, QCoreApplication::translate("bench", "write the JSON report to this file (default: stdout)"), "file");
+    QCommandLineOption cliRuns("runs", QCoreApplication::translate("bench", "runs per case and thread count (default: 5)"), "count", "5");
+    QCommandLineOption cliThreads("threads", QCoreApplication::translate("bench", "comma-separated bake thread counts (default: powers of two up to, and including, all cores)"), "counts");
+    QCommandLineOption cliLayerGrain("layer-grain", QCoreApplication::translate("bench", "minimum layers per parallel task (default: 1)"), "layers", "1");
+    QCommandLineOption cliToleranceIndex("tolerance-index", QCoreApplication::translate("bench", "keep the PDV-sorted index, so recullTolerance uses a prefix search instead of a scan"));
+    QCommandLineOption cliHugePages("huge-pages", QCoreApplication::translate("bench", "advise grid buffers as transparent huge pages (Linux only)"));
+    QCommandLineOption cliNoSynthetic("no-synthetic", QCoreApplication::translate("bench", "skip the synthetic shallow/deep x narrow/wide cases"));
+    qParser.addHelpOption();
+    qParser.addVersionOption();
+    qParser.addOption(cliConfigs);
+    qParser.addOption(cliOutput);
+    qParser.addOption(cliRuns);
+    qParser.addOption(cliThreads);
+    qParser.addOption(cliLayerGrain);
+    qParser.addOption(cliToleranceIndex);
+    qParser.addOption(cliHugePages);
+    qParser.addOption(cliNoSynthetic);
+    qParser.process(app);
+
+    int runs = std::max(1, qParser.value(cliRuns).toInt());
+    bool toleranceIndex = qParser.isSet(cliToleranceIndex);
+    bufferHugePages = qParser.isSet(cliHugePages);
+    CloudManager::setLayerGrain(qParser.value(cliLayerGrain).toInt());
+
+    int cores = int(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts;
+    if (qParser.isSet(cliThreads)) {
+        for (const QString &count : qParser.value(cliThreads).split(',', Qt::SkipEmptyParts)) {
+            if (count.toInt() > 0) {
+                threadCounts.push_back(count.toInt());
+            }
+        }
+    } else {
+        for (int p = 1; p < cores; p <<= 1) {
+            threadCounts.push_back(p);
+        }
+        threadCounts.push_back(cores);
+    }
+    if (threadCounts.empty()) {
+        std::cerr << "No valid thread counts in \"" << qParser.value(cliThreads).toStdString() << "\"" << std::endl;
+        return 1;
+    }
+
+    // Cases: every shipped cloud config, then the synthetic sets of CloudManager::testThreadingInit()
+    std::vector<BenchCase> cases;
+    FileHandler fileHandler;
+    QDir configDir(qParser.value(cliConfigs));
+    for (const QString &file : configDir.entryList({ "*.cloud" }, QDir::Files, QDir::Name)) {
+        BenchCase bc;
+        SuperConfig loaded = fileHandler.loadConfigFile(configDir.filePath(file), &bc.recipes);
+        if (!std::holds_alternative<AtomixCloudConfig>(loaded) || bc.recipes.empty()) {
+            std::cerr << "Skipping " << file.toStdString() << ": not a cloud config with recipes" << std::endl;
+            continue;
+        }
+        bc.name = QFileInfo(file).completeBaseName().toStdString();
+        bc.source = configDir.filePath(file).toStdString();
+        bc.cfg = std::get<AtomixCloudConfig>(loaded);
+        cases.push_back(bc);
+    }
+    if (!qParser.isSet(cliNoSynthetic)) {
+        AtomixCloudConfig shallow, deep;
+        shallow.cloudResolution = 120;
+        shallow.cloudLayDivisor = 2;
+        deep.cloudResolution = 360;
+        deep.cloudLayDivisor = 6;
+
+        harmap narrow, wide;
+        narrow[8].push_back(ivec3(1, 0, 1));
+        for (int l = 7; l >= 0; l--) {
+            for (int m = l; m >= -l; m--) {
+                wide[8].push_back(ivec3(l, m, 1));
+            }
+        }
+
+        cases.push_back({ "shallow-narrow", "synthetic", shallow, narrow });
+        cases.push_back({ "shallow-wide", "synthetic", shallow, wide });
+        cases.push_back({ "deep-narrow", "synthetic", deep, narrow });
+        cases.push_back({ "deep-wide", "synthetic", deep, wide });
+    }
+    if (cases.empty()) {
+        std::cerr << "Nothing to benchmark" << std::endl;
+        return 1;
+    }
+
+    // Benchmark
+    QJsonArray caseReports;
+    for (BenchCase &bc : cases) {
+        QJsonArray results;
+        uint64_t voxels = 0, visible = 0;
+        for (int threads : threadCounts) {
+            std::cerr << "Benchmarking " << bc.name << " on " << threads << " thread(s)..." << std::endl;
+            results.append(benchCase(bc, threads, runs, toleranceIndex, voxels, visible));
+        }
+
+        int terms = 0;
+        for (auto const &[n, orbitals] : bc.recipes) {
+            terms += int(orbitals.size());
+        }
+        QJsonObject report;
+        report["name"] = QString::fromStdString(bc.name);
+        report["source"] = QString::fromStdString(bc.source);
+        report["resolution"] = bc.cfg.cloudResolution;
+        report["divisor"] = bc.cfg.cloudLayDivisor;
+        report["tolerance"] = bc.cfg.cloudTolerance;
+        report["recipes"] = terms;
+        report["voxels"] = qint64(voxels);
+        report["visible"] = qint64(visible);
+        report["results"] = results;
+        caseReports.append(report);
+    }
+
+    QJsonObject root;
+    root["bakeVersion"] = int(ATOMIX_BAKE_VERSION);
+    root["hardwareThreads"] = cores;
+    root["runs"] = runs;
+    root["layerGrain"] = qParser.value(cliLayerGrain).toInt();
+    root["toleranceIndex"] = toleranceIndex;
+    root["hugePages"] = bufferHugePages;
+    root["cases"] = caseReports;
+    QByteArray json = QJsonDocument(root).toJson();
+
+    if (qParser.isSet(cliOutput)) {
+        QFile outFile(qParser.value(cliOutput));
+        if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || (outFile.write(json) != json.size())) {
+            std::cerr << "Failed to write " << qParser.value(cliOutput).toStdString() << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << json.toStdString();
+    }
+
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * cloudcache.cpp
+ *
+ *    Created on: Jan 8, 2025
+ *   Last Update: Jan 8, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <tuple>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "cloudcache.hpp"
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+
+namespace fs = std::filesystem;
+
+
+/**
+ * @brief Map a whole file read-only.
+ *
+ * @param path The file to map.
+ * @param size The size of the file, from std::filesystem.
+ * @return The mapping, or nullptr on failure.
+ */
+static const uint8_t *mapReadOnly(const std::string &path, uint64_t size) {
+    void *view = nullptr;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        view = nullptr;
+    }
+#endif
+    return static_cast<const uint8_t *>(view);
+}
+
+/**
+ * @brief Unmap a file mapped by mapReadOnly().
+ */
+static void unmapReadOnly(const uint8_t *view, [[maybe_unused]] uint64_t size) {
+#ifdef _WIN32
+    UnmapViewOfFile(view);
+#else
+    munmap(const_cast<uint8_t *>(view), size);
+#endif
+}
+
+
+/**
+ * @brief Set the directory used for cache files, creating it if needed.
+ *
+ * @details
+ * An empty directory, or one that cannot be created, leaves the cache disabled.
+ *
+ * @param dir The cache directory.
+ * @param maxBytes The maximum total size of all cache files in the directory.
+ */
+void CloudCache::setDirectory(const std::string &dir, uint64_t maxBytes) {
+    std::error_code ec;
+    this->cacheDir.clear();
+    this->capBytes = maxBytes;
+
+    if (dir.empty() || (!fs::exists(dir, ec) && !fs::create_directories(dir, ec))) {
+        return;
+    }
+    this->cacheDir = dir;
+    if (this->cacheDir.back() != '/') {
+        this->cacheDir += '/';
+    }
+}
+
+/**
+ * @brief Hash everything that determines the baked PDVs and their tolerance culling.
+ *
+ * @details
+ * FNV-1a over ATOMIX_BAKE_VERSION, resolution, divisor, tolerance, layer count, and every
+ * (n, l, m, weight) recipe. Culling sliders and render mode do not affect the bake and are
+ * excluded.
+ *
+ * @param cfg The cloud config.
+ * @param layers The number of layers (opt_max_radius) of the cloud.
+ * @param recipes The orbital recipes.
+ * @return The 64-bit cache key.
+ */
+uint64_t CloudCache::makeKey(const AtomixCloudConfig &cfg, int layers, const harmap &recipes) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](const void *bytes, size_t len) {
+        const unsigned char *b = static_cast<const unsigned char *>(bytes);
+        for (size_t i = 0; i < len; i++) {
+            hash ^= b[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+
+    mix(&ATOMIX_BAKE_VERSION, sizeof(ATOMIX_BAKE_VERSION));
+    mix(&cfg.cloudResolution, sizeof(cfg.cloudResolution));
+    mix(&cfg.cloudLayDivisor, sizeof(cfg.cloudLayDivisor));
+    mix(&cfg.cloudTolerance, sizeof(cfg.cloudTolerance));
+    mix(&layers, sizeof(layers));
+    for (auto const &[n, orbitals] : recipes) {
+        mix(&n, sizeof(n));
+        for (auto const &v : orbitals) {
+            int lmw[3] = { v.x, v.y, v.z };
+            mix(lmw, sizeof(lmw));
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Check whether a cache file exists for `key`, without validating or mapping it.
+ *
+ * @param key The cache key from makeKey().
+ * @return True if a file for `key` exists.
+ */
+bool CloudCache::contains(uint64_t key) {
+    std::error_code ec;
+    return this->enabled() && fs::exists(pathFor(key), ec);
+}
+
+/**
+ * @brief Map the cache file for `key`, if one exists and is valid.
+ *
+ * @details
+ * Files with a wrong magic, version, key, or size are deleted, as are files holding more
+ * indices than PDVs or any index outside the PDVs, since the indices are later used as
+ * offsets into the cloud's buffers and as vertex ids. A hit refreshes the file's
+ * modification time, which is what trim() uses for LRU ordering. Any previous mapping is
+ * released first.
+ *
+ * @param key The cache key from makeKey().
+ * @param[out] entry Pointers into the mapped file, valid until release().
+ * @return True on a hit.
+ */
+bool CloudCache::load(uint64_t key, CloudCacheEntry &entry) {
+    this->release();
+    if (!this->enabled()) {
+        return false;
+    }
+
+    std::string path = pathFor(key);
+    std::error_code ec;
+    uint64_t fileSize = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    if (fileSize >= sizeof(CloudCacheHeader)) {
+        this->mapPtr = mapReadOnly(path, fileSize);
+        this->mapSize = (this->mapPtr) ? fileSize : 0;
+    }
+
+    const CloudCacheHeader *header = reinterpret_cast<const CloudCacheHeader *>(this->mapPtr);
+    CloudCacheHeader expected;
+    bool valid = header && !std::memcmp(header->magic, expected.magic, sizeof(expected.magic))
+        && (header->version == expected.version) && (header->headerSize == expected.headerSize) && (header->key == key)
+        && (header->indexCount <= header->dataCount) && (header->dataCount <= fileSize / sizeof(float))
+        && (fileSize == sizeof(CloudCacheHeader) + header->dataCount * sizeof(float) + header->indexCount * sizeof(uint));
+    if (valid) {
+        const uint *indices = reinterpret_cast<const uint *>(this->mapPtr + sizeof(CloudCacheHeader) + header->dataCount * sizeof(float));
+        uint64_t dataCount = header->dataCount;
+        valid = !std::any_of(std::execution::par_unseq, indices, indices + header->indexCount, [dataCount](uint idx) {
+            return idx >= dataCount;
+        });
+    }
+    if (!valid) {
+        this->release();
+        fs::remove(path, ec);
+        return false;
+    }
+
+    entry.header = header;
+    entry.data = reinterpret_cast<const float *>(this->mapPtr + sizeof(CloudCacheHeader));
+    entry.indices = reinterpret_cast<const uint *>(this->mapPtr + sizeof(CloudCacheHeader) + header->dataCount * sizeof(float));
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    return true;
+}
+
+/**
+ * @brief Unmap and close the currently loaded cache file, if any.
+ */
+void CloudCache::release() {
+    if (this->mapPtr) {
+        unmapReadOnly(this->mapPtr, this->mapSize);
+        this->mapPtr = nullptr;
+        this->mapSize = 0;
+    }
+}
+
+/**
+ * @brief Write a baked cloud to the cache, then trim the directory to its cap.
+ *
+ * @details
+ * The file is written under a temporary name and renamed into place, so a reader never
+ * maps a partial file. Clouds larger than the cap are not stored.
+ *
+ * @param key The cache key from makeKey().
+ * @param pdvMax The maximum PDV that `data` was normalized against.
+ * @param data The normalized PDVs for every vertex.
+ * @param indices The tolerance-culled vertex indices.
+ * @return True if the file was written.
+ */
+bool CloudCache::store(uint64_t key, double pdvMax, std::span<const float> data, std::span<const uint> indices) {
+    if (!this->enabled()) {
+        return false;
+    }
+
+    uint64_t fileSize = sizeof(CloudCacheHeader) + data.size() * sizeof(float) + indices.size() * sizeof(uint);
+    if (fileSize > this->capBytes) {
+        return false;
+    }
+
+    std::string path = pathFor(key);
+    std::string tmpPath = path + ".tmp";
+    bool written = writeFile(tmpPath, key, pdvMax, data, indices);
+
+    std::error_code ec;
+    if (written) {
+        fs::rename(tmpPath, path, ec);
+    }
+    if (!written || ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    this->trim();
+    return true;
+}
+
+/**
+ * @brief Write a baked cloud to `path` in the cache file format, replacing any existing file.
+ *
+ * @details
+ * Used by store(), and by tools that bake clouds outside the GUI (see bake.cpp).
+ *
+ * @param path The file to write.
+ * @param key The cache key from makeKey().
+ * @param pdvMax The maximum PDV that `data` was normalized against.
+ * @param data The normalized PDVs for every vertex.
+ * @param indices The tolerance-culled vertex indices.
+ * @return True if the whole file was written.
+ */
+bool CloudCache::writeFile(const std::string &path, uint64_t key, double pdvMax, std::span<const float> data, std::span<const uint> indices) {
+    CloudCacheHeader header;
+    header.key = key;
+    header.dataCount = data.size();
+    header.indexCount = indices.size();
+    header.pdvMax = pdvMax;
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (!outFile) {
+        return false;
+    }
+    outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float));
+    outFile.write(reinterpret_cast<const char *>(indices.data()), indices.size() * sizeof(uint));
+    outFile.close();
+
+    return bool(outFile);
+}
+
+/**
+ * @brief Get the cache file path for `key`.
+ */
+std::string CloudCache::pathFor(uint64_t key) {
+    return this->cacheDir + std::format("{:016x}", key) + CACHEXT;
+}
+
+/**
+ * @brief Delete the least recently used cache files until the directory fits its cap.
+ */
+void CloudCache::trim() {
+    std::error_code ec;
+    std::vector<std::tuple<fs::file_time_type, uint64_t, fs::path>> files;
+    uint64_t total = 0;
+
+    for (auto const &dirEntry : fs::directory_iterator(this->cacheDir, ec)) {
+        if (!dirEntry.is_regular_file(ec) || dirEntry.path().extension() != CACHEXT) {
+            continue;
+        }
+        uint64_t size = dirEntry.file_size(ec);
+        files.emplace_back(dirEntry.last_write_time(ec), size, dirEntry.path());
+        total += size;
+    }
+    std::sort(files.begin(), files.end());
+
+    for (auto const &[time, size, path] : files) {
+        if (total <= this->capBytes) {
+            break;
+        }
+        if (fs::remove(path, ec)) {
+            total -= size;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * cloudcache.hpp
+ *
+ *    Created on: Jan 8, 2025
+ *   Last Update: Jan 8, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLOUDCACHE_H
+#define CLOUDCACHE_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "global.hpp"
+
+
+// Bump whenever a change to the bake alters its output, so stale cache files are discarded
+const uint32_t ATOMIX_BAKE_VERSION = 1;
+
+/* On-disk header preceding the float PDV array and the uint tolerance-culled index list */
+struct CloudCacheHeader {
+    char magic[8] = { 'A', 'T', 'X', 'C', 'L', 'O', 'U', 'D' };
+    uint32_t version = ATOMIX_BAKE_VERSION;
+    uint32_t headerSize = sizeof(CloudCacheHeader);
+    uint64_t key = 0;
+    uint64_t dataCount = 0;
+    uint64_t indexCount = 0;
+    double pdvMax = 0.0;
+};
+
+/* A mapped cache entry; pointers are valid until CloudCache::release() */
+struct CloudCacheEntry {
+    const CloudCacheHeader *header = nullptr;
+    const float *data = nullptr;
+    const uint *indices = nullptr;
+};
+
+
+/**
+ * CloudCache
+ *
+ * @brief Persistent, memory-mapped store of baked clouds.
+ *
+ * @details
+ * Each baked cloud is written as one binary file named by a hash of the bake-relevant
+ * config fields, the layer count, the recipes, and ATOMIX_BAKE_VERSION. Loading maps the
+ * file and hands out pointers into the mapping, so no parsing or baking is needed. The
+ * directory is capped by total size, evicting the least recently used files first.
+ */
+class CloudCache {
+public:
+    CloudCache() {};
+    ~CloudCache() { release(); };
+
+    void setDirectory(const std::string &dir, uint64_t maxBytes = DEFAULT_CAP);
+    bool enabled() { return !this->cacheDir.empty(); }
+
+    static uint64_t makeKey(const AtomixCloudConfig &cfg, int layers, const harmap &recipes);
+    bool contains(uint64_t key);
+    bool load(uint64_t key, CloudCacheEntry &entry);
+    void release();
+    bool store(uint64_t key, double pdvMax, std::span<const float> data, std::span<const uint> indices);
+    static bool writeFile(const std::string &path, uint64_t key, double pdvMax, std::span<const float> data, std::span<const uint> indices);
+
+    static const uint64_t DEFAULT_CAP = uint64_t(2) << 30;
+
+private:
+    std::string pathFor(uint64_t key);
+    void trim();
+
+    std::string cacheDir;
+    uint64_t capBytes = DEFAULT_CAP;
+    const uint8_t *mapPtr = nullptr;
+    uint64_t mapSize = 0;
+
+    const std::string CACHEXT = ".atxc";
+};
+
+#endif
@@ -0,0 +1,288 @@
+/**
+ * cloudestimator.cpp
+ *
+ *    Created on: Jan 14, 2025
+ *   Last Update: Jan 14, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <set>
+
+#include "cloudestimator.hpp"
+#include "cloudmanager.hpp"
+
+
+/**
+ * @brief Set the file the calibrated rates persist in, and load them from it if it exists.
+ *
+ * @param path The calibration file.
+ */
+void CloudEstimator::setFile(const std::string &path) {
+    std::lock_guard<std::mutex> guard(this->ce_lock);
+    this->calFile = path;
+
+    std::ifstream inFile(path);
+    double grid = 0.0, term = 0.0;
+    if ((inFile >> grid >> term) && (grid > 0.0) && (term > 0.0)) {
+        this->gridNs = grid;
+        this->termNs = term;
+        this->calibrated = true;
+    }
+
+    // Byte scales were added later, so files without them keep the defaults
+    double gridBytes = 0.0, visibleBytes = 0.0, fieldBytes = 0.0;
+    if ((inFile >> gridBytes >> visibleBytes >> fieldBytes) && (gridBytes > 0.0) && (visibleBytes > 0.0) && (fieldBytes > 0.0)) {
+        this->gridScale = gridBytes;
+        this->visibleScale = visibleBytes;
+        this->fieldScale = fieldBytes;
+    }
+}
+
+/**
+ * @brief Predict the host bytes of the buffers and fields CloudManager allocates for a cloud.
+ *
+ * @details
+ * Grid-sized buffers are allData, and for CPU renders the vertex and colour arrays, or for
+ * quantized GPU renders the packed PDVs. Visible-sized buffers are the tolerance-culled
+ * indices, the IBO, and the packed PDVs of gathered streams. Snapshots hold the uploaded
+ * buffers among them. The fields are one radial column of `layers` doubles per unique
+ * (n,l), and one angular field of a layer's cells per unique (l,m).
+ *
+ * @param cfg The cloud config.
+ * @param recipes The orbital recipes.
+ * @param visible The count of voxels above tolerance.
+ * @param format The GPU storage format of the PDVs.
+ * @param gather True if the cloud is drawn from gathered streams.
+ * @return The predicted bytes, unscaled.
+ */
+CloudHostBytes CloudEstimator::hostBytes(const AtomixCloudConfig &cfg, const harmap &recipes, uint64_t visible, CloudDataFormat format, bool gather) {
+    CloudHostBytes bytes;
+    if (recipes.empty()) {
+        return bytes;
+    }
+
+    uint64_t layer_size = uint64_t(cfg.cloudResolution) * (cfg.cloudResolution >> 1);
+    uint64_t layers = CloudManager::getMaxLayer(cfg.cloudTolerance, recipes.rbegin()->first, cfg.cloudLayDivisor);
+    uint64_t V = layers * layer_size;
+    uint64_t N = visible;
+
+    std::set<std::pair<int, int>> radKeys, angKeys;
+    for (auto const &[n, orbitals] : recipes) {
+        for (auto const &v : orbitals) {
+            radKeys.emplace(n, v.x);
+            angKeys.emplace(v.x, v.y);
+        }
+    }
+
+    uint64_t width = (cfg.cpu || format == CloudDataFormat::FLOAT32) ? sizeof(float)
+                   : (format == CloudDataFormat::UNORM8) ? sizeof(uint8_t) : sizeof(uint16_t);
+    bool packed = !cfg.cpu && (gather || width != sizeof(float));
+    uint64_t vertexBytes = (cfg.cpu) ? V * sizeof(glm::vec4) : 0;
+    uint64_t colourBytes = (cfg.cpu) ? V * sizeof(glm::vec4) : 0;
+
+    bytes.grid = V * sizeof(float) + vertexBytes + colourBytes + ((packed && !gather) ? V * width : 0);
+    bytes.visible = 2 * N * sizeof(uint) + ((packed && gather) ? N * width : 0);
+    bytes.heldGrid = vertexBytes + colourBytes + ((gather && !cfg.cpu) ? 0 : V * ((packed) ? width : sizeof(float)));
+    bytes.heldVisible = N * sizeof(uint) + ((gather && !cfg.cpu) ? N * width : 0);
+    bytes.field = radKeys.size() * layers * sizeof(double) + angKeys.size() * layer_size * sizeof(std::complex<double>);
+    return bytes;
+}
+
+/**
+ * @brief Predict the peak memory and bake time of a cloud config.
+ *
+ * @details
+ * Host memory peaks either while baking, with the grid buffers, the bake's separable
+ * fields, and up to a budget of fields the cache kept from earlier recipes, or once the
+ * snapshot is published, with the grid and visible buffers and the fields the cache keeps.
+ * Both include the previous cloud's snapshot, which the render thread holds throughout.
+ * Each kind of byte term is scaled as calibrated by record(). Device memory is the sum of
+ * the uploaded buffers, plus a staging buffer for the largest one.
+ *
+ * @param cfg The cloud config.
+ * @param recipes The orbital recipes.
+ * @param format The GPU storage format of the PDVs.
+ * @param gather True if the cloud is drawn from gathered streams (see CloudManager::setGatherStreams()).
+ * @return The predicted cost.
+ */
+CloudEstimate CloudEstimator::estimate(const AtomixCloudConfig &cfg, const harmap &recipes, CloudDataFormat format, bool gather) {
+    CloudEstimate est;
+    if (recipes.empty()) {
+        return est;
+    }
+
+    uint64_t layer_size = uint64_t(cfg.cloudResolution) * (cfg.cloudResolution >> 1);
+    uint64_t layers = CloudManager::getMaxLayer(cfg.cloudTolerance, recipes.rbegin()->first, cfg.cloudLayDivisor);
+    uint64_t V = layers * layer_size;
+
+    int terms = 0;
+    for (auto const &[n, orbitals] : recipes) {
+        terms += int(orbitals.size());
+    }
+
+    double fraction = VISIBLE_DEFAULT;
+    double gScale, vScale, fScale;
+    uint64_t budget;
+    {
+        std::lock_guard<std::mutex> guard(this->ce_lock);
+        if ((this->visibleFraction > 0.0) && (this->visibleTolerance == cfg.cloudTolerance) && (this->visibleRecipes == recipes)) {
+            fraction = this->visibleFraction;
+        }
+        est.bakeMs = (double(V) * (this->gridNs + this->termNs * terms)) * 1.0e-6;
+        gScale = this->gridScale;
+        vScale = this->visibleScale;
+        fScale = this->fieldScale;
+        budget = this->fieldBudget;
+    }
+    uint64_t N = uint64_t(double(V) * fraction);
+    uint64_t width = (cfg.cpu || format == CloudDataFormat::FLOAT32) ? sizeof(float)
+                   : (format == CloudDataFormat::UNORM8) ? sizeof(uint8_t) : sizeof(uint16_t);
+
+    CloudHostBytes bytes = hostBytes(cfg, recipes, N, format, gather);
+    uint64_t grid = uint64_t(gScale * double(bytes.grid));
+    uint64_t visible = uint64_t(vScale * double(bytes.visible));
+    uint64_t field = uint64_t(fScale * double(bytes.field));
+    uint64_t kept = std::min(field, budget);
+    uint64_t held = uint64_t(gScale * double(bytes.heldGrid) + vScale * double(bytes.heldVisible));
+
+    uint64_t bakePeak = grid + field + kept + held;
+    uint64_t publishPeak = grid + visible + kept + held;
+    est.voxels = V;
+    est.visible = N;
+    est.hostBytes = std::max(bakePeak, publishPeak);
+
+    // Buffers uploaded to the device
+    uint64_t vertexBytes = (cfg.cpu) ? V * sizeof(glm::vec4) : 0;
+    uint64_t colourBytes = (cfg.cpu) ? V * sizeof(glm::vec4) : 0;
+    uint64_t dataBytes = (!cfg.cpu && gather) ? N * width : V * width;
+    uint64_t indexBytes = N * sizeof(uint);
+
+    uint64_t uploaded = (cfg.cpu) ? (vertexBytes + colourBytes + indexBytes) : (dataBytes + indexBytes);
+    est.deviceBytes = uploaded + std::max({ vertexBytes, colourBytes, (cfg.cpu) ? 0 : dataBytes, indexBytes });
+
+    return est;
+}
+
+/**
+ * @brief Scale the resolution and layer divisor of `cfg` to the largest grid that fits a budget.
+ *
+ * @details
+ * The ratio of resolution to divisor is kept, so the shape of the voxels does not change:
+ * each divisor from MAX_DIVISOR down is tried with its matching (even) resolution, and the
+ * first grid that fits is taken. If even a divisor of 1 does not fit, its resolution is
+ * lowered down to MIN_RESOLUTION. Grids whose voxel indices would overflow a uint never fit.
+ *
+ * @param[in,out] cfg The cloud config, whose resolution and divisor are replaced on success.
+ * @param recipes The orbital recipes.
+ * @param format The GPU storage format of the PDVs.
+ * @param gather True if the cloud is drawn from gathered streams.
+ * @param hostBudget The host memory cap in bytes, or 0 for none.
+ * @param deviceBudget The device memory cap in bytes, or 0 for none.
+ * @return True if a grid fits, False if `cfg` was left unchanged.
+ */
+bool CloudEstimator::fitBudget(AtomixCloudConfig &cfg, const harmap &recipes, CloudDataFormat format, bool gather, uint64_t hostBudget, uint64_t deviceBudget) {
+    AtomixCloudConfig trial = cfg;
+    double ratio = double(std::max(cfg.cloudResolution, MIN_RESOLUTION)) / std::max(cfg.cloudLayDivisor, 1);
+
+    auto fits = [&](int res, int div) {
+        trial.cloudResolution = res;
+        trial.cloudLayDivisor = div;
+        CloudEstimate est = this->estimate(trial, recipes, format, gather);
+        return (est.voxels <= std::numeric_limits<uint>::max())
+            && (!hostBudget || est.hostBytes <= hostBudget) && (!deviceBudget || est.deviceBytes <= deviceBudget);
+    };
+    auto accept = [&cfg](int res, int div) {
+        cfg.cloudResolution = res;
+        cfg.cloudLayDivisor = div;
+        return true;
+    };
+
+    for (int div = MAX_DIVISOR; div >= 1; div--) {
+        int res = std::clamp(int(ratio * div) & ~1, MIN_RESOLUTION, MAX_RESOLUTION);
+        if (fits(res, div)) {
+            return accept(res, div);
+        }
+    }
+    for (int res = std::clamp(int(ratio) & ~1, MIN_RESOLUTION, MAX_RESOLUTION) - 2; res >= MIN_RESOLUTION; res -= 2) {
+        if (fits(res, 1)) {
+            return accept(res, 1);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Fold the measurements of a finished bake into the model.
+ *
+ * @details
+ * Each byte scale is the measured bytes of its kind over those hostBytes() predicts for the
+ * same bake, so allocator slack and buffers kept at a larger capacity are learned as well.
+ *
+ * @param sample The bake's voxel and visible counts, recipe count, stage times, and measured bytes.
+ */
+void CloudEstimator::record(const CloudBakeSample &sample) {
+    if (!sample.voxels || !sample.terms) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(this->ce_lock);
+
+    this->visibleFraction = double(sample.visible) / double(sample.voxels);
+    this->visibleTolerance = sample.tolerance;
+    this->visibleRecipes = sample.recipes;
+
+    // The first measured bake replaces the defaults outright
+    double weight = (this->calibrated) ? SMOOTHING : 1.0;
+    double term = (sample.bakeMs * 1.0e6) / (double(sample.voxels) * sample.terms);
+    this->termNs += weight * (term - this->termNs);
+    if (sample.createMs >= 0.0) {
+        double grid = ((sample.createMs + sample.cullMs) * 1.0e6) / double(sample.voxels);
+        this->gridNs += weight * (grid - this->gridNs);
+    }
+
+    CloudHostBytes predicted = hostBytes(sample.cfg, sample.recipes, sample.visible, sample.format, sample.gather);
+    auto calibrate = [weight](double &scale, uint64_t measured, uint64_t predicted) {
+        if (measured && predicted) {
+            scale += weight * ((double(measured) / double(predicted)) - scale);
+        }
+    };
+    calibrate(this->gridScale, sample.gridBytes, predicted.grid);
+    calibrate(this->visibleScale, sample.visibleBytes, predicted.visible);
+    calibrate(this->fieldScale, sample.fieldBytes, predicted.field);
+    if (sample.fieldBudget) {
+        this->fieldBudget = sample.fieldBudget;
+    }
+    this->calibrated = true;
+
+    this->save();
+}
+
+/**
+ * @brief Write the calibrated rates to the calibration file, if one is set.
+ */
+void CloudEstimator::save() {
+    if (this->calFile.empty()) {
+        return;
+    }
+    std::ofstream outFile(this->calFile, std::ios::trunc);
+    outFile << this->gridNs << " " << this->termNs << " " << this->gridScale << " " << this->visibleScale << " " << this->fieldScale << "\n";
+}
@@ -0,0 +1,123 @@
+/**
+ * cloudestimator.hpp
+ *
+ *    Created on: Jan 14, 2025
+ *   Last Update: Jan 14, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLOUDESTIMATOR_H
+#define CLOUDESTIMATOR_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "global.hpp"
+
+
+/* Predicted cost of baking and drawing one cloud config */
+struct CloudEstimate {
+    uint64_t voxels = 0;
+    uint64_t visible = 0;       // Voxels expected above tolerance
+    uint64_t hostBytes = 0;     // Peak host memory, from the bake through the published snapshot
+    uint64_t deviceBytes = 0;   // Device memory of the uploaded buffers, plus the largest staging buffer
+    double bakeMs = 0.0;        // Create, bake, and tolerance cull, without the disk cache
+};
+
+/* Measurements of one finished bake, fed back to calibrate the model */
+struct CloudBakeSample {
+    uint64_t voxels = 0;
+    uint64_t visible = 0;
+    int terms = 0;              // Recipe count
+    double createMs = -1.0;     // Negative if the grid was kept from the last bake
+    double bakeMs = 0.0;
+    double cullMs = 0.0;
+    double tolerance = 0.0;
+    harmap recipes;
+    AtomixCloudConfig cfg;      // Grid and render mode of the bake
+    CloudDataFormat format = CloudDataFormat::FLOAT32;
+    bool gather = false;
+    uint64_t gridBytes = 0;     // Measured host bytes of the buffers sized by the grid
+    uint64_t visibleBytes = 0;  // Measured host bytes of the buffers sized by the visible count
+    uint64_t fieldBytes = 0;    // Measured bytes of the separable fields the bake used; 0 for BakeMode::PER_VOXEL
+    uint64_t fieldBudget = 0;   // The field cache budget (CloudManager::setFieldCacheBudget())
+};
+
+/* Host bytes of a cloud, by what they scale with */
+struct CloudHostBytes {
+    uint64_t grid = 0;          // Buffers sized by the grid
+    uint64_t visible = 0;       // Buffers sized by the visible count
+    uint64_t heldGrid = 0;      // Of those, the ones a published snapshot holds
+    uint64_t heldVisible = 0;
+    uint64_t field = 0;         // Separable radial and angular fields
+};
+
+
+/**
+ * CloudEstimator
+ *
+ * @brief Predicts the peak memory and bake time of a cloud config, and fits configs to a budget.
+ *
+ * @details
+ * Memory follows from the buffers CloudManager allocates, sized by the voxel count of the
+ * grid and the count of voxels expected above tolerance, and from the separable fields of
+ * the bake, which the field cache keeps up to its budget. The previous cloud, which the
+ * render thread holds until the new one is published, is counted at the new one's size.
+ * The visible fraction is the one last measured for the same recipes and tolerance, or all
+ * voxels otherwise. Time is linear in voxels for the grid passes, and in voxels times
+ * recipes for the bake. The rates, and a scale for each kind of byte term, are smoothed
+ * over the bakes CloudManager reports through record(), and persisted.
+ */
+class CloudEstimator {
+public:
+    CloudEstimator() {};
+    ~CloudEstimator() {};
+
+    void setFile(const std::string &path);
+    CloudEstimate estimate(const AtomixCloudConfig &cfg, const harmap &recipes, CloudDataFormat format, bool gather);
+    bool fitBudget(AtomixCloudConfig &cfg, const harmap &recipes, CloudDataFormat format, bool gather, uint64_t hostBudget, uint64_t deviceBudget);
+    void record(const CloudBakeSample &sample);
+
+    static const int MIN_RESOLUTION = 16;
+    static const int MAX_RESOLUTION = 4096;
+    static const int MAX_DIVISOR = 64;
+
+private:
+    void save();
+    static CloudHostBytes hostBytes(const AtomixCloudConfig &cfg, const harmap &recipes, uint64_t visible, CloudDataFormat format, bool gather);
+
+    std::mutex ce_lock;
+    std::string calFile;
+    double gridNs = 5.0;                // Create and tolerance cull, per voxel
+    double termNs = 3.0;                // Bake, per voxel per recipe
+    double gridScale = 1.0;             // Measured over predicted bytes, per kind of byte term
+    double visibleScale = 1.0;
+    double fieldScale = 1.0;
+    uint64_t fieldBudget = 256 * 1024 * 1024;
+    bool calibrated = false;            // The rates come from a measured bake, not the defaults
+    double visibleFraction = 0.0;
+    double visibleTolerance = 0.0;
+    harmap visibleRecipes;
+
+    const double VISIBLE_DEFAULT = 1.0;
+    const double SMOOTHING = 0.3;       // Weight of the newest sample in the rates
+};
+
+#endif
@@ -23,12 +23,19 @@
  */
 
 #include "cloudmanager.hpp"
+#include <bit>
 #include <ranges>
+#include <glm/gtc/packing.hpp>
 
 // std::execution (via TBB) and Qt both use the emit keyword, so undef for this file to avoid conflicts 
 #undef emit
 #include <oneapi/dpl/algorithm>
 #include <oneapi/dpl/execution>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/info.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_group.h>
 
 
 /**
@@ -49,9 +56,113 @@ CloudManager::CloudManager() {
  * number.
  */
 CloudManager::~CloudManager() {
+    reclaimBuffer(this->packedData, this->packedLoan, this->snapPublished.dataData);
     resetManager();
 }
 
+/*
+ *  Scheduling
+ */
+
+/* The arenas all cloud work runs in, rebuilt by CloudManager::setBakeThreads() */
+struct BakeArenas {
+    std::unique_ptr<tbb::task_arena> bake;                  // Every request runs in here, capped at getBakeThreads()
+    std::vector<std::unique_ptr<tbb::task_arena>> nodes;    // One per NUMA node, pinned to it, if there are several
+};
+
+/**
+ * @brief Get the arenas cloud requests run in, building them on first use or on `rebuild`.
+ *
+ * @details
+ * The bake arena caps every parallel algorithm a request runs, so a bake leaves the cores
+ * beyond getBakeThreads() to the GUI and render threads. The NUMA arenas split the same
+ * thread count over the nodes. They exist only on multi-node machines where TBB can see
+ * the topology (it needs tbbbind and hwloc); otherwise forEachLayer() stays in the bake arena.
+ */
+static BakeArenas &bakeArenas(bool rebuild = false) {
+    static BakeArenas arenas;
+    if (rebuild || !arenas.bake) {
+        int threads = CloudManager::getBakeThreads();
+        arenas.bake = std::make_unique<tbb::task_arena>(threads);
+        arenas.nodes.clear();
+
+        std::vector<tbb::numa_node_id> nodes = tbb::info::numa_nodes();
+        if (nodes.size() > 1) {
+            int perNode = std::max(1, (threads + int(nodes.size()) - 1) / int(nodes.size()));
+            for (tbb::numa_node_id node : nodes) {
+                arenas.nodes.push_back(std::make_unique<tbb::task_arena>(tbb::task_arena::constraints{}.set_numa_id(node).set_max_concurrency(perNode)));
+            }
+        }
+    }
+    return arenas;
+}
+
+/**
+ * @brief Set the number of threads cloud requests run on, and rebuild their arenas.
+ *
+ * @details
+ * Call only while no request runs, such as at startup or from a scaling sweep.
+ *
+ * @param threads The thread count, or 0 for all cores but one.
+ */
+void CloudManager::setBakeThreads(int threads) {
+    bakeThreads = std::max(0, threads);
+    bakeArenas(true);
+}
+
+/**
+ * @brief Get the number of threads cloud requests run on.
+ *
+ * @return The count set by setBakeThreads(), or all cores but one if unset.
+ */
+int CloudManager::getBakeThreads() {
+    return (bakeThreads > 0) ? bakeThreads : std::max(1, tbb::info::default_concurrency() - 1);
+}
+
+/**
+ * @brief Run `fn(layer)` for every layer of the grid in parallel, in blocks of at least layerGrain layers.
+ *
+ * @details
+ * With several NUMA nodes, node k always runs the k-th contiguous share of the layers, each
+ * statically partitioned over its pinned workers. allData is sized without being touched
+ * (see BufferAllocator), so its pages are first touched by the bake on the node that runs
+ * their layer, and every later pass through here reads them from local memory. Otherwise
+ * blocks are balanced dynamically, as layer costs vary with the recipes and symmetries.
+ *
+ * @param fn The per-layer work, called concurrently.
+ */
+template <typename F>
+void CloudManager::forEachLayer(F &&fn) {
+    int layers = this->opt_max_radius;
+    int grain = layerGrain;
+    auto body = [&fn](const tbb::blocked_range<int> &range) {
+        for (int layer = range.begin(); layer != range.end(); layer++) {
+            fn(layer);
+        }
+    };
+
+    auto &arenas = bakeArenas().nodes;
+    if (arenas.empty()) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, layers, grain), body);
+        return;
+    }
+
+    int nodes = int(arenas.size());
+    std::vector<tbb::task_group> groups(nodes);
+    for (int k = 0; k < nodes; k++) {
+        int first = int((int64_t(layers) * k) / nodes);
+        int last = int((int64_t(layers) * (k + 1)) / nodes);
+        arenas[k]->execute([&groups, &body, k, first, last, grain] {
+            groups[k].run([&body, first, last, grain] {
+                tbb::parallel_for(tbb::blocked_range<int>(first, last, grain), body, tbb::static_partitioner());
+            });
+        });
+    }
+    for (int k = 0; k < nodes; k++) {
+        arenas[k]->execute([&groups, k] { groups[k].wait(); });
+    }
+}
+
 /**
  * @brief Set the configuration for the cloud rendering process.
  *
@@ -97,12 +208,37 @@ void CloudManager::receiveCloudMap(harmap *inMap) {
  * This function is called by the VKWindow class when a new configuration is set.
  * It checks for relevant config or map changes and updates the manager accordingly.
  *
+ * A generating request supersedes any request still running or waiting: the running one
+ * skips its remaining stages (see abandonRequest()) and a waiting one returns unprocessed.
+ * Any stage whose mStatus flag is missing, because its request was cancelled, is redone
+ * along with those the changes call for.
+ *
  * @param config A pointer to the new configuration.
  * @param inMap A pointer to the new orbital map.
  * @param generator True if this may generate a new cloud render, False if only culling.
  */
 void CloudManager::receiveCloudMapAndConfig(AtomixCloudConfig *config, harmap *inMap, bool generator) {
+    uint64_t request = (generator) ? ++this->requestSerial : this->requestSerial.load();
+    bakeArenas().bake->execute([this, config, inMap, generator, request] {
+        this->processRequest(config, inMap, generator, request);
+    });
+}
+
+/**
+ * @brief Process a request from receiveCloudMapAndConfig(), inside the bake arena.
+ *
+ * @param config A pointer to the new configuration.
+ * @param inMap A pointer to the new orbital map.
+ * @param generator True if this may generate a new cloud render, False if only culling.
+ * @param request The requestSerial this request was given on arrival.
+ */
+void CloudManager::processRequest(AtomixCloudConfig *config, harmap *inMap, bool generator, uint64_t request) {
     cm_proc_coarse.lock();
+    this->activeRequest = request;
+    if (this->cancelled()) {
+        cm_proc_coarse.unlock();
+        return;
+    }
 
     if (mStatus.hasNone(em::INIT)) {
         newConfig(config);
@@ -110,6 +246,10 @@ void CloudManager::receiveCloudMapAndConfig(AtomixCloudConfig *config, harmap *i
         this->opt_max_radius = getMaxLayer(this->cloudTolerance, this->max_n, this->cloudLayerDivisor);
         initManager();
         mStatus.set(em::INIT);
+        if (!this->cancelled()) {
+            this->publishSnapshot();
+        }
+        this->beginStage(BakeStage::IDLE, 0);
         cm_proc_coarse.unlock();
         return;
     }
@@ -123,18 +263,22 @@ void CloudManager::receiveCloudMapAndConfig(AtomixCloudConfig *config, harmap *i
     bool newCulling = false;
     bool higherMaxN = false;
 
+    // Compare against cfg, as a progressive bake may still be running on a decimated grid
     if (generator) {
-        widerRadius = (getMaxLayer(config->cloudTolerance, inMap->rbegin()->first, config->cloudLayDivisor) > this->opt_max_radius);
+        widerRadius = (getMaxLayer(config->cloudTolerance, inMap->rbegin()->first, config->cloudLayDivisor) > getMaxLayer(this->cloudTolerance, this->max_n, this->cfg.cloudLayDivisor));
         newMap = cloudOrbitals != (*inMap);
-        newDivisor = (this->cloudLayerDivisor != config->cloudLayDivisor);
-        newResolution = (this->cloudResolution != config->cloudResolution);
+        newDivisor = (this->cfg.cloudLayDivisor != config->cloudLayDivisor);
+        newResolution = (this->cfg.cloudResolution != config->cloudResolution);
         newTolerance = (this->cloudTolerance != config->cloudTolerance);
         higherMaxN = (mStatus.hasAny(em::VERT_READY)) && (inMap->rbegin()->first > this->max_n);
     }
     newCulling = (this->cfg.cloudCull_x != config->cloudCull_x) || (this->cfg.cloudCull_y != config->cloudCull_y) || (this->cfg.cloudCull_rIn != config->cloudCull_rIn) || (this->cfg.cloudCull_rOut != config->cloudCull_rOut);
     
     bool configChanged = (newDivisor || newResolution || newTolerance);
-    bool newVerticesRequired = (newDivisor || newResolution || higherMaxN || widerRadius);
+    bool newVerticesRequired = (newDivisor || newResolution || higherMaxN || widerRadius || mStatus.hasNone(em::VERT_READY));
+    if ((configChanged || newMap) && this->hasRefinement()) {
+        newVerticesRequired = true;
+    }
 
     // Resest or clear if necessary
     if (newVerticesRequired) {
@@ -159,35 +303,77 @@ void CloudManager::receiveCloudMapAndConfig(AtomixCloudConfig *config, harmap *i
         mStatus.set(em::UPD_MATRICES);
     }
 
-    this->opt_max_radius = getMaxLayer(this->cloudTolerance, this->max_n, this->cloudLayerDivisor);
+    // The layer count belongs to the vertex grid, so only changes with it (a narrower tolerance just culls more)
+    if (newVerticesRequired) {
+        this->opt_max_radius = getMaxLayer(this->cloudTolerance, this->max_n, this->cloudLayerDivisor);
+    }
+
+    // Plan the job's progress as voxels per stage: create, bake, and cull each take one unit per voxel.
+    // A slider cull between progressive passes joins the progressive job instead.
+    bool bakeRequired = (newVerticesRequired || newMap || mStatus.hasNone(em::DATA_READY));
+    bool cullRequired = (bakeRequired || newTolerance || mStatus.hasNone(em::INDEX_GEN));
+    if (generator || !this->hasRefinement()) {
+        uint64_t voxels = (newVerticesRequired) ? this->passVoxels(1) : this->pixelCount;
+        this->beginJob(voxels * (uint64_t(newVerticesRequired) + uint64_t(bakeRequired) + uint64_t(cullRequired)));
+    }
+
+    // Large new grids are streamed coarse-to-fine, starting with the coarsest pass; recipe edits on a
+    // standing grid bake in place instead, so the field cache carries the unchanged orbitals over
+    if (newVerticesRequired && this->planProgressive()) {
+        this->refineCloudPass();
+        newVerticesRequired = newMap = newTolerance = newCulling = bakeRequired = false;
+    }
 
     // Re-gen vertices for new config values if necessary
     if (newVerticesRequired) {
         mStatus.clear(em::VERT_READY);
         cm_times[0] = createThreaded();
     }
-    // Re-gen PDVs for new map or if otherwise necessary
-    if (newVerticesRequired || newMap) {
-        mStatus.clear(em::DATA_READY);
-        cm_times[1] = bakeOrbitalsThreaded();
+    // Re-gen PDVs for new map or if otherwise necessary, from the disk cache if possible
+    bool newBake = false;
+    bool newLoad = false;
+    if (bakeRequired) {
+        mStatus.clear(em::DATA_READY | em::INDEX_GEN);
+        newBake = !loadCachedCloud();
+        newLoad = !newBake;
+        if (newBake) {
+            cm_times[1] = bakeOrbitalsThreaded();
+        } else {
+            this->jobDone.fetch_add(this->pixelCount, std::memory_order_relaxed);
+        }
     }
     // Re-cull the indices for tolerance or if otherwise necessary
-    if (newVerticesRequired || newMap || newTolerance) {
+    bool newCull = (newBake || newTolerance || mStatus.hasNone(em::INDEX_GEN));
+    if (newCull) {
         mStatus.clear(em::INDEX_GEN);
-        cm_times[2] = cullToleranceThreaded();
-        if (cfg.cpu) expandPDVsToColours();
+        cm_times[4] = cullToleranceThreaded();
+    }
+    if (newBake) {
+        storeCachedCloud();
+    }
+    if ((newLoad || newCull) && cfg.cpu) {
+        expandPDVsToColours();
     }
     // Re-cull the indices for slider position or if otherwise necessary
-    if (newVerticesRequired || newMap || newTolerance || newCulling) {
+    if (newLoad || newCull || newCulling || mStatus.hasNone(em::INDEX_READY)) {
         mStatus.clear(em::INDEX_READY);
-        cm_times[3] = cullSliderThreaded();
+        cm_times[5] = cullSliderThreaded();
     }
     
-    if (isProfiling) {
-        std::cout << "receiveCloudMapAndConfig() -- Functions took:\n";
-        this->printTimes();
+    if (this->cancelled()) {
+        this->abandonRequest();
+    } else {
+        if (newBake) {
+            this->recordBake(newVerticesRequired);
+        }
+        this->publishSnapshot();
+        if (isProfiling) {
+            std::cout << "receiveCloudMapAndConfig() -- Functions took:\n";
+            this->printTimes();
+        }
     }
 
+    this->beginStage(BakeStage::IDLE, 0);
     cm_proc_coarse.unlock();
 }
 
@@ -200,13 +386,27 @@ void CloudManager::receiveCloudMapAndConfig(AtomixCloudConfig *config, harmap *i
  * be handled by the receiveCloudMapAndConfig function.
  */
 void CloudManager::initManager() {
-    cm_times[0] = createThreaded();
-    cm_times[1] = bakeOrbitalsThreaded();
-    cm_times[2] = cullToleranceThreaded();
-    if (cfg.cpu) expandPDVsToColours();
-    cm_times[3] = cullSliderThreaded();
+    if (this->planProgressive()) {
+        this->refineCloudPass();
+    } else {
+        this->beginJob(3 * this->passVoxels(1));
+        cm_times[0] = createThreaded();
+        bool baked = !loadCachedCloud();
+        if (baked) {
+            cm_times[1] = bakeOrbitalsThreaded();
+            cm_times[4] = cullToleranceThreaded();
+            storeCachedCloud();
+        }
+        if (cfg.cpu) expandPDVsToColours();
+        cm_times[5] = cullSliderThreaded();
+        if (baked) {
+            this->recordBake(true);
+        }
+    }
 
-    if (isProfiling) {
+    if (this->cancelled()) {
+        this->abandonRequest();
+    } else if (isProfiling) {
         std::cout << "Init() -- Functions took:\n";
         this->printTimes();
     }
@@ -214,6 +414,309 @@ void CloudManager::initManager() {
     mStatus.set(em::UPD_MATRICES);
 }
 
+/**
+ * @brief Run the next pass of a progressive bake.
+ *
+ * @details
+ * Called by VKWindow, in its own thread, once the previous pass has been published. Each
+ * call refines the cloud by one step until hasRefinement() returns false.
+ */
+void CloudManager::refineCloud() {
+    uint64_t request = this->requestSerial.load();
+    bakeArenas().bake->execute([this, request] {
+        this->processRefinement(request);
+    });
+}
+
+/**
+ * @brief Run the next pass of a progressive bake for refineCloud(), inside the bake arena.
+ *
+ * @param request The requestSerial as of the refineCloud() call.
+ */
+void CloudManager::processRefinement(uint64_t request) {
+    cm_proc_coarse.lock();
+    this->activeRequest = request;
+
+    if (this->hasRefinement() && !this->cancelled()) {
+        this->refineCloudPass();
+
+        if (this->cancelled()) {
+            this->abandonRequest();
+        } else {
+            this->publishSnapshot();
+            if (isProfiling) {
+                std::cout << "refineCloud() -- Functions took:\n";
+                this->printTimes();
+            }
+        }
+    }
+
+    this->beginStage(BakeStage::IDLE, 0);
+    cm_proc_coarse.unlock();
+}
+
+/**
+ * @brief Decide whether the current bake should be streamed coarse-to-fine, and plan its passes.
+ *
+ * @details
+ * Bakes of more than PROGRESSIVE_PIXELS voxels are split into passes on decimated grids,
+ * each halving the step of the last: the resolution (kept even, and at least 16) and the
+ * layer divisor (at least 1) are divided by the step. Unless both divide evenly, a coarse
+ * grid's angles and radii do not lie on the full grid, so each pass is an independent grid
+ * that is created and baked from scratch, and only the final pass uses the config grid. The
+ * coarsest pass is the first step whose grid fits within PROGRESSIVE_PIXELS, which keeps
+ * time-to-first-image roughly constant regardless of the final resolution. Clouds already
+ * in the disk cache load directly instead.
+ *
+ * @return True if refineSteps now holds a plan, False for a single full bake.
+ */
+bool CloudManager::planProgressive() {
+    this->refineSteps.clear();
+
+    int res = this->cfg.cloudResolution;
+    int div = this->cfg.cloudLayDivisor;
+    int fullLayers = getMaxLayer(this->cloudTolerance, this->max_n, div);
+
+    if (!this->progressive || (this->passVoxels(1) <= PROGRESSIVE_PIXELS)
+        || this->diskCache.contains(CloudCache::makeKey(this->cfg, fullLayers, this->cloudOrbitals))) {
+        return false;
+    }
+
+    // Each pass creates, bakes, and culls its grid, and the job spans them all
+    uint64_t jobUnits = 0;
+    for (int step = 1; ; step <<= 1) {
+        this->refineSteps.insert(this->refineSteps.begin(), step);
+        jobUnits += 3 * this->passVoxels(step);
+        if ((this->passVoxels(step) <= PROGRESSIVE_PIXELS) || ((res / step) <= 16)) {
+            break;
+        }
+    }
+    this->beginJob(jobUnits);
+
+    return true;
+}
+
+/**
+ * @brief Get the grid resolution of the progressive pass at `step`.
+ *
+ * @details
+ * Coarse passes are rounded down to an even resolution of at least 16. The final pass
+ * (step 1) is the config resolution exactly, so it matches a non-progressive bake and
+ * the disk cache key.
+ */
+int CloudManager::passResolution(int step) {
+    return (step == 1) ? this->cfg.cloudResolution : std::max(16, (this->cfg.cloudResolution / step) & ~1);
+}
+
+/**
+ * @brief Get the voxel count of the grid of the progressive pass at `step`; step 1 is the config grid.
+ */
+uint64_t CloudManager::passVoxels(int step) {
+    int res_s = this->passResolution(step);
+    int div_s = std::max(1, this->cfg.cloudLayDivisor / step);
+    return uint64_t(getMaxLayer(this->cloudTolerance, this->max_n, div_s)) * res_s * (res_s >> 1);
+}
+
+/**
+ * @brief Bake, cull, and publish the next (coarsest remaining) pass of a progressive bake.
+ *
+ * @details
+ * Regrids the manager to the pass's decimated resolution and divisor and runs the full
+ * pipeline, so the UPD_VBO/UPD_DATA/UPD_IBO flags are set for the next snapshot. The
+ * final pass runs on the full config grid and is stored to the disk cache as usual.
+ */
+void CloudManager::refineCloudPass() {
+    int step = this->refineSteps.front();
+    this->refineSteps.erase(this->refineSteps.begin());
+
+    this->cloudResolution = this->passResolution(step);
+    this->cloudLayerDivisor = std::max(1, this->cfg.cloudLayDivisor / step);
+    this->deg_fac = TWO_PI / this->cloudResolution;
+    this->opt_max_radius = getMaxLayer(this->cloudTolerance, this->max_n, this->cloudLayerDivisor);
+
+    bool updMatrices = mStatus.hasAny(em::UPD_MATRICES);
+    this->resetManager();
+    if (updMatrices) {
+        mStatus.set(em::UPD_MATRICES);
+    }
+    cm_times[0] = createThreaded();
+    cm_times[1] = bakeOrbitalsThreaded();
+    cm_times[4] = cullToleranceThreaded();
+    if (step == 1) {
+        storeCachedCloud();
+    }
+    if (cfg.cpu) expandPDVsToColours();
+    cm_times[5] = cullSliderThreaded();
+    if (step == 1) {
+        this->recordBake(true);
+    }
+}
+
+/**
+ * @brief Fill a snapshot with the buffers and the vertex grid they were built on.
+ *
+ * @param snap The snapshot to fill.
+ * @param flags The UPD_* flags whose buffers to fill.
+ * @param lend True to lend the buffers to the snapshot until they are next written, False to point at the live ones.
+ */
+void CloudManager::fillSnapshot(ManagerSnapshot &snap, uint flags, bool lend) {
+    Manager::fillSnapshot(snap, flags, lend);
+    snap.gridResolution = this->cloudResolution;
+    snap.gridDivisor = this->cloudLayerDivisor;
+    snap.gridLayers = this->opt_max_radius;
+    snap.sliderRanges = this->iboHoldsTolerance && !this->idxIsPdvPrefix;
+}
+
+/**
+ * @brief Lend the PDVs uploaded to the GPU to a snapshot: packedData if quantized or gathered, otherwise allData.
+ */
+std::shared_ptr<const void> CloudManager::lendData() {
+    return (this->packedData.empty()) ? Manager::lendData() : lendBuffer(this->packedData, this->packedLoan, this->dataSize);
+}
+
+/**
+ * @brief Re-cull a published snapshot for new slider positions, without the manager.
+ *
+ * @details
+ * Lets the render thread answer slider moves while a bake holds the manager. Only works
+ * while the snapshot's IBO holds the voxel-ordered tolerance cull, as the sliders then only
+ * select draw ranges of it; the buffers themselves are shared with `snap`.
+ *
+ * @param snap The snapshot to re-cull.
+ * @param config The cloud config holding the new slider positions.
+ * @return A snapshot flagged with the new ranges, or null if `snap` cannot be re-culled.
+ */
+std::shared_ptr<const ManagerSnapshot> CloudManager::cullSnapshot(const ManagerSnapshot &snap, const AtomixCloudConfig &config) {
+    if (!snap.sliderRanges || !snap.indexData) {
+        return nullptr;
+    }
+
+    auto culled = std::make_shared<ManagerSnapshot>(snap);
+    auto ranges = std::make_shared<std::vector<DrawRange>>();
+    const uint *idxBegin = static_cast<const uint *>(snap.indexData.get());
+    uint64_t idxCount = snap.indexSize / sizeof(uint);
+
+    bool visible = !bool(int(config.cloudCull_x) + int(config.cloudCull_y) + int(config.cloudCull_rIn) + int(config.cloudCull_rOut));
+    bool untouched = !(config.cloudCull_x || config.cloudCull_y || config.cloudCull_rIn || config.cloudCull_rOut);
+    if (visible && !untouched) {
+        genSliderRanges(sliderBounds(config, snap.gridResolution, snap.gridLayers), idxBegin, idxBegin + idxCount, *ranges);
+        visible = !ranges->empty();
+    }
+    culled->indexCount = (visible) ? idxCount : 0;
+    culled->drawRanges = ranges;
+    culled->flags = em::UPD_IDXOFF | em::UPD_RANGES;
+    return culled;
+}
+
+/**
+ * @brief Get the progress of the stage the current request is in.
+ *
+ * @details
+ * Safe to call from any thread while a request runs. Work units are counted in chunks of
+ * a layer or a PER_VOXEL slab, so `done` advances in steps rather than per voxel.
+ *
+ * @return The current stage with its completed and total work units.
+ */
+BakeProgress CloudManager::getProgress() {
+    BakeProgress progress;
+    progress.stage = this->progressStage.load(std::memory_order_relaxed);
+    progress.total = this->progressTotal.load(std::memory_order_relaxed);
+    progress.done = std::min(this->progressDone.load(std::memory_order_relaxed), progress.total);
+    progress.jobTotal = this->jobTotal.load(std::memory_order_relaxed);
+    progress.jobDone = std::min(this->jobDone.load(std::memory_order_relaxed), progress.jobTotal);
+    return progress;
+}
+
+/**
+ * @brief Start reporting progress for `stage`, which will take `total` work units.
+ *
+ * @details
+ * A stage the job plan did not count extends the job total instead. The slider cull is
+ * left out of the job altogether, as it takes milliseconds and its total is only known
+ * once the tolerance cull is done.
+ */
+void CloudManager::beginStage(BakeStage stage, uint64_t total) {
+    this->progressDone.store(0, std::memory_order_relaxed);
+    this->progressTotal.store(total, std::memory_order_relaxed);
+    this->progressStage.store(stage, std::memory_order_relaxed);
+    uint64_t jobNeeded = this->jobDone.load(std::memory_order_relaxed) + total;
+    if ((stage != BakeStage::SLIDER) && (this->jobTotal.load(std::memory_order_relaxed) < jobNeeded)) {
+        this->jobTotal.store(jobNeeded, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Start reporting progress for a new job, whose stages and passes will take `total` work units.
+ */
+void CloudManager::beginJob(uint64_t total) {
+    this->jobDone.store(0, std::memory_order_relaxed);
+    this->jobTotal.store(total, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Report the times, visible count, and buffer sizes of the bake just finished to the estimator.
+ *
+ * @details
+ * Coarse progressive passes are not reported, since their decimated grids would be
+ * recorded against the config's full grid.
+ *
+ * @param created True if the grid was created for this bake, so cm_times[0] belongs to it.
+ */
+void CloudManager::recordBake(bool created) {
+    if (!this->estimator || this->cancelled()) {
+        return;
+    }
+
+    CloudBakeSample sample;
+    sample.voxels = this->pixelCount;
+    sample.visible = this->idxCulledTolerance.size();
+    sample.terms = int(this->numOrbitals);
+    sample.createMs = (created) ? cm_times[0] : -1.0;
+    sample.bakeMs = cm_times[1];
+    sample.cullMs = cm_times[4];
+    sample.tolerance = this->cloudTolerance;
+    sample.recipes = this->cloudOrbitals;
+    sample.cfg = this->cfg;
+    sample.cfg.cloudResolution = this->cloudResolution;
+    sample.cfg.cloudLayDivisor = this->cloudLayerDivisor;
+    sample.format = this->dataFormat;
+    sample.gather = this->gatherStreams;
+
+    size_t packedBytes = this->packedData.capacity();
+    sample.gridBytes = this->allData.capacity() * sizeof(float) + this->allVertices.capacity() * sizeof(glm::vec4)
+                     + this->allColours.capacity() * sizeof(glm::vec4) + ((this->gatherStreams) ? 0 : packedBytes);
+    sample.visibleBytes = (this->allIndices.capacity() + this->idxCulledTolerance.capacity()) * sizeof(uint)
+                        + ((this->gatherStreams) ? packedBytes : 0);
+    sample.fieldBytes = this->bakeFieldBytes;
+    sample.fieldBudget = this->fieldCacheBudget;
+    this->estimator->record(sample);
+}
+
+/**
+ * @brief Leave the manager consistent after its request was cancelled part-way.
+ *
+ * @details
+ * Every stage that ran to completion has set its mStatus flag and any stage that was
+ * skipped or cut short has not, so the next request redoes exactly the missing stages.
+ * A cancelled progressive pass leaves a decimated grid behind, which is dropped along
+ * with the rest of the plan: the config grid is restored and the next request regrids
+ * and replans from scratch.
+ * Pending UPD_* flags are kept, since they describe buffers that were completed.
+ */
+void CloudManager::abandonRequest() {
+    if ((this->cloudResolution != this->cfg.cloudResolution) || (this->cloudLayerDivisor != this->cfg.cloudLayDivisor)) {
+        this->refineSteps.clear();
+        this->cloudResolution = this->cfg.cloudResolution;
+        this->cloudLayerDivisor = this->cfg.cloudLayDivisor;
+        this->deg_fac = TWO_PI / this->cloudResolution;
+        mStatus.clear(em::VERT_READY);
+    }
+
+    if (isProfiling) {
+        std::cout << "Request cancelled." << std::endl;
+    }
+}
+
 /**
  * @brief Generate the vertices and colour data for the cloud render in separate threads.
  *
@@ -222,9 +725,16 @@ void CloudManager::initManager() {
  * It is used for generating the initial cloud render when the cloud manager is first
  * initialized.
  *
+ * Only CPU rendering needs vertices. In GPU mode, gpu_harmonics.vert rebuilds each point
+ * from its index and the grid (resolution and divisor) push constants, so this only sizes
+ * allData and flags the push constants for update.
+ *
  * @return The time taken to complete the function in milliseconds.
  */
 double CloudManager::createThreaded() {
+    if (this->cancelled()) {
+        return 0.0;
+    }
     assert(mStatus.hasNone(em::VERT_READY));
     cm_proc_fine.lock();
     steady_clock::time_point begin = steady_clock::now();
@@ -236,223 +746,911 @@ double CloudManager::createThreaded() {
     double deg_fac_local = this->deg_fac;
     this->pixelCount = this->opt_max_radius * theta_max_local * phi_max_local;
     bool isGPU = !cfg.cpu;
+    this->beginStage(BakeStage::CREATE, this->pixelCount);
+
+    /*  Memory -- Sized but not filled; the bake writes (and so first touches) every voxel  */
+    reclaimBuffer(allData, dataLoan, snapPublished.dataData);
+    reclaimBuffer(allVertices, vertexLoan, snapPublished.vertexData);
+    // A coarse progressive pass keeps any allocation that fits the final grid, which the last pass will need
+    uint64_t finalCount = this->passVoxels(1);
+    this->sizeBuffer(allData, pixelCount, finalCount);
+
+    // The GPU shader rebuilds (r, theta, phi) from the vertex index and the grid push constants, so it needs no vertices
+    if (isGPU) {
+        allVertices.clear();
+        allVertices.shrink_to_fit();
+        this->vertexCount = 0;
+        this->vertexSize = 0;
+        mStatus.set(em::VERT_READY | em::UPD_PUSH_CONST);
+        this->advance(this->pixelCount);
+        steady_clock::time_point end = steady_clock::now();
+        cm_proc_fine.unlock();
+        return (std::chrono::duration<double, std::milli>(end - begin).count());
+    }
 
-    /*  Memory -- Begin --- This memory-carving portion takes 94% of create() total time  */
-    // auto beginInner = steady_clock::now();
-    allVertices.reserve(pixelCount);
-    dataStaging.reserve(pixelCount);
-    allData.reserve(pixelCount);
-    idxCulledTolerance.reserve(pixelCount);
+    this->sizeBuffer(allVertices, pixelCount, finalCount);
 
-    allVertices.assign(pixelCount, vec4(0.0f));
-    dataStaging.assign(pixelCount, 0.0);
-    allData.assign(pixelCount, 0.0f);
+    /*  Compute -- Begin  */
+    // auto beginInner = steady_clock::now();
+    vec4 *start = &this->allVertices.at(0);
+    std::for_each(std::execution::par_unseq, allVertices.begin(), allVertices.end(),
+        [layer_size, phi_max_local, deg_fac_local, div_local, start](glm::vec4 &gVector){
+            int i = int(&gVector - start);
+            int layer = (i / layer_size) + 1;
+            int layer_pos = i % layer_size;
+            float theta = (layer_pos / phi_max_local) * deg_fac_local;
+            float phi = (layer_pos % phi_max_local) * deg_fac_local;
+            float radius = static_cast<float>(layer) / div_local;
 
-    wavefuncNorms(MAX_SHELLS);
+            gVector.x = radius * sin(phi) * sin(theta);
+            gVector.y = radius * cos(phi);
+            gVector.z = radius * sin(phi) * cos(theta);
+            gVector.w = 0.0f;
+        });
     // auto endInner = steady_clock::now();
     // auto createTime = std::chrono::duration<double, std::milli>(endInner - beginInner).count();
-    // std::cout << "Create Memory Loop took: " << createTime << " ms" << std::endl;
+    // std::cout << "Create Inner Loop took: " << createTime << " ms" << std::endl;
+
+    /*  Exit  */
+    mStatus.set(em::VERT_READY);
+    genVertexArray();
+    this->advance(this->pixelCount);
+    steady_clock::time_point end = steady_clock::now();
+    cm_proc_fine.unlock();
+    return (std::chrono::duration<double, std::milli>(end - begin).count());
+}
+
+/**
+ * @brief Generates the cloud data for the given orbital recipes using threads.
+ *
+ * @details
+ * This function is the threaded version of bakeOrbitals(). It is the most time-
+ * consuming part of the cloud rendering process. The function first flattens the
+ * orbital recipes via bakeRecipes(), then dispatches to the compute strategy chosen
+ * by `bakeMode`, which writes the PDV of every voxel straight into allData [** as FLOATS **]
+ * and the maximum of each layer into layerMax. The overall maximum is stored in
+ * allPDVMaximum. A single pass per layer then normalizes allData in place and counts the
+ * voxels above the current tolerance into layerCounts, which cullToleranceThreaded()
+ * uses to compact the survivors. No full-size double or index buffers are allocated.
+ * Finally, the function sets the `em::DATA_READY` status.
+ *
+ * @return The time taken to complete the function in milliseconds.
+ */
+double CloudManager::bakeOrbitalsThreaded() {
+    if (this->cancelled()) {
+        return 0.0;
+    }
+    assert(mStatus.hasFirstNotLast(em::VERT_READY, em::DATA_READY));
+    cm_proc_fine.lock();
+    steady_clock::time_point begin = steady_clock::now();
+    this->beginStage(BakeStage::BAKE, this->pixelCount);
+
+    // A snapshot still showing the previous cloud keeps its PDVs, so this bake writes fresh ones
+    if (reclaimBuffer(allData, dataLoan, snapPublished.dataData)) {
+        this->sizeBuffer(allData, this->pixelCount);
+    }
+
+    /*  Prep -- Compute  */
+    BakeRecipes recipes;
+    this->bakeRecipes(recipes);
+
+    /*  Compute -- Begin
+        This section contains 62%-98% of the total execution time of cloud generation,
+        which can easily scale into Ne+1 minutes for high resolutions.
+    */
+    this->layerMax.assign(this->opt_max_radius, 0.0);
+    this->bakeFieldBytes = 0;
+    if (this->bakeMode != BakeMode::PER_VOXEL) {
+        this->bakeTables(recipes);
+    } else {
+        this->bakePerVoxel(recipes);
+    }
+
+    // A cancelled bake leaves allData partial, so DATA_READY stays clear for the next request to redo
+    if (this->cancelled()) {
+        this->pdvOrderValid = false;
+        this->bakeCulled = false;
+        cm_proc_fine.unlock();
+        return 0.0;
+    }
+
+    /*  Compute -- Post-processing  */
+    // Reduce the per-layer maxima
+    this->allPDVMaximum = *std::max_element(layerMax.cbegin(), layerMax.cend());
+
+    // Normalize PDVs against Maximum in place, counting each layer's voxels above tolerance for the cull
+    int layer_size = this->cloudResolution * (this->cloudResolution >> 1);
+    double pdvMax = this->allPDVMaximum;
+    float tolerance_local = this->cloudTolerance;
+    float *dataStart = &allData[0];
+    this->layerCounts.assign(this->opt_max_radius, 0);
+    uint *countStart = &layerCounts[0];
+    this->forEachLayer(
+        [dataStart, countStart, layer_size, pdvMax, tolerance_local](int layer) {
+            float *block = dataStart + (size_t(layer) * layer_size);
+            uint count = 0;
+            for (int i = 0; i < layer_size; i++) {
+                block[i] = static_cast<float>(block[i] / pdvMax);
+                count += (block[i] > tolerance_local);
+            }
+            countStart[layer] = count;
+        });
+    this->countedTolerance = tolerance_local;
+    this->pdvOrderValid = false;
+    this->bakeCulled = false;
+
+    /*  Exit  */
+    mStatus.set(em::DATA_READY);
+    genDataBuffer();
+    steady_clock::time_point end = steady_clock::now();
+    cm_proc_fine.unlock();
+    return (std::chrono::duration<double, std::milli>(end - begin).count());
+}
+
+/**
+ * @brief Flatten the current orbital map into per-recipe arrays for baking.
+ *
+ * @details
+ * Each recipe in `cloudOrbitals` contributes its quantum numbers, its weight
+ * (normalized so all weights sum to 1), and its radial and angular normalization
+ * constants. The sum of all l values is also recorded, as an all-s recipe set
+ * scales its PDVs by 4pi.
+ *
+ * The symmetries of |Psi|^2 are detected here as well. Each term carries e^(i m theta),
+ * so if every recipe has the same m, the phase factors out and |Psi|^2 does not depend
+ * on theta (opposite m values interfere, so a shared |m| is not enough). Likewise
+ * P_l^m(-x) = (-1)^(l+m) P_l^m(x), so if every recipe has the same parity of l+|m|,
+ * |Psi|^2 is mirror-symmetric about the equatorial plane. The grid only holds that mirror
+ * (ring p at pi - phi is ring phi_max - p) when the resolution is even, so odd resolutions
+ * never use it.
+ *
+ * @param[out] recipes The BakeRecipes struct to populate.
+ */
+void CloudManager::bakeRecipes(BakeRecipes &recipes) {
+    int numRecipes = this->countMapRecipes(&cloudOrbitals);
+    recipes.count = numRecipes;
+    recipes.total_l = 0;
+    recipes.ns.assign(numRecipes, 0);
+    recipes.ls.assign(numRecipes, 0);
+    recipes.ms.assign(numRecipes, 0);
+    recipes.ws.assign(numRecipes, 0.0);
+    recipes.ny.assign(numRecipes, 0.0);
+    recipes.nr.assign(numRecipes, 0.0);
+
+    int rIdx = 0;
+    for (auto const &[key, val] : cloudOrbitals) {
+        for (auto const &v : val) {
+            recipes.ns[rIdx] = key;
+            recipes.ls[rIdx] = v.x;
+            recipes.ms[rIdx] = v.y;
+            recipes.ws[rIdx] = v.z;
+            recipes.ny[rIdx] = atomix::orbitals::norm_angular(v.x, v.y);
+            recipes.nr[rIdx] = atomix::orbitals::norm_radial(key, v.x);
+            recipes.total_l += v.x;
+            rIdx++;
+        }
+    }
+
+    recipes.azimuthal = std::all_of(recipes.ms.cbegin(), recipes.ms.cend(), [&recipes](int m_l) {
+        return m_l == recipes.ms[0];
+    });
+    recipes.equatorial = !(this->cloudResolution & 1);
+    for (int r = 0; r < numRecipes; r++) {
+        recipes.equatorial &= (((recipes.ls[r] + std::abs(recipes.ms[r])) & 1) == ((recipes.ls[0] + std::abs(recipes.ms[0])) & 1));
+    }
+
+    double weightSum = std::accumulate(recipes.ws.cbegin(), recipes.ws.cend(), 0.0);
+    std::for_each(std::execution::par_unseq, recipes.ws.begin(), recipes.ws.end(), [weightSum](double &weight) {
+        weight /= weightSum;
+    });
+}
+
+/**
+ * @brief Write PDVs into allData by evaluating every recipe in full at every voxel.
+ *
+ * @details
+ * This is the original (reference) bake. Each voxel computes its own Laguerre and
+ * Legendre recurrences and complex exponential for every recipe, even though the
+ * radial term only depends on the layer and the angular term only on the (theta, phi)
+ * cell. Kept for validation of the faster modes and for profiling comparisons.
+ *
+ * Voxels are dispatched in slabs of whole layers, about CANCEL_CHUNK voxels each, so a
+ * cancelled request stops within one slab.
+ *
+ * @param recipes The flattened recipes from bakeRecipes().
+ */
+void CloudManager::bakePerVoxel(const BakeRecipes &recipes) {
+    const std::vector<int> &ns = recipes.ns;
+    const std::vector<int> &ls = recipes.ls;
+    const std::vector<int> &ms = recipes.ms;
+    const dvec &ws = recipes.ws;
+    const dvec &ny = recipes.ny;
+    const dvec &nr = recipes.nr;
+    int numRecipes = recipes.count;
+    float *dataStart = &this->allData[0];
+    int layer_size = this->cloudResolution * (this->cloudResolution >> 1);
+    int phi_max_local = this->cloudResolution >> 1;
+    int div_local = this->cloudLayerDivisor;
+    double deg_fac_local = this->deg_fac;
+    size_t slab_size = std::max(uint64_t(1), CANCEL_CHUNK / layer_size) * layer_size;
+
+    for (size_t slab = 0; slab < allData.size(); slab += slab_size) {
+        if (this->cancelled()) {
+            return;
+        }
+        auto slabEnd = allData.begin() + std::min(slab + slab_size, allData.size());
+
+        // I'm unrolling all the pretty functions that go into this calc (hyperoptimization).
+        std::for_each(std::execution::par_unseq, allData.begin() + slab, slabEnd,
+            [&ns, &ls, &ms, &ws, &ny, &nr, dataStart, numRecipes, layer_size, phi_max_local, div_local, deg_fac_local](float &item) {
+                uint idx = uint(&item - dataStart);
+                std::complex<double> Psi;
+                int layer_pos = idx % layer_size;
+                double radius = static_cast<float>((idx / layer_size) + 1) / div_local;
+                double theta = static_cast<float>((layer_pos / phi_max_local) * deg_fac_local);
+                double phi = static_cast<float>((layer_pos % phi_max_local) * deg_fac_local);
+                double pdv = 0.0;
+                double pdv_factor = radius * radius;
+                int total_l = 0;
+
+                // Recipe Loop
+                for (int r = 0; r < numRecipes; r++) {
+                    int n = ns[r];
+                    int l = ls[r];
+                    int m_l = ms[r];
+                    double angNorm = ny[r];
+                    double radNorm = nr[r];
+                    double weight = ws[r];
+                    total_l += l;
+            
+                    // Radial wavefunc
+                    double rho = 2.0 * radius / static_cast<double>(n);
+                    double rhol = 1.0;
+                        // (exponential subroutine for rho^l to avoid time cost of pow())
+                    for (int l_times = l; l_times > 0; l_times--) {
+                        rhol *= rho;
+                    }
+                    double R = lagp((n - l - 1), ((l << 1) + 1), rho) * rhol * exp(-rho * 0.5) * radNorm;
+
+                    // Angular wavefunc
+                    std::complex<double> Y = exp(std::complex<double>{0,1} * (m_l * theta)) * angNorm * legp(l, abs(m_l), cos(phi));
+                    Psi += R * Y * weight;
+                }
+
+                if (!total_l) {
+                    pdv_factor *= 4.0 * M_PI;
+                }
+                pdv = (std::conj(Psi) * Psi).real() * pdv_factor;
+                dataStart[idx] = static_cast<float>(pdv);
+
+            }); // End of Lambda
+        this->advance(slabEnd - (allData.begin() + slab));
+    }
+
+    // Per-layer maxima for normalization
+    double *maxStart = &this->layerMax[0];
+    this->forEachLayer(
+        [dataStart, maxStart, layer_size](int layer) {
+            const float *block = dataStart + (size_t(layer) * layer_size);
+            maxStart[layer] = *std::max_element(block, block + layer_size);
+        });
+}
+
+/**
+ * @brief Write PDVs into allData from separable radial and angular tables.
+ *
+ * @details
+ * Psi = sum_r w_r * R(n_r, l_r, r) * Y(l_r, m_r, theta, phi), and R only depends on the
+ * layer while Y only depends on the (theta, phi) cell. Each orbital's field is therefore
+ * kept in fieldCache as one radial column per unique (n,l) and one normalized angular
+ * field per unique (l,m), and only the factors missing from the cache are baked (see
+ * bakeFields()). The angular fields of each (n,l) group are then pre-summed per cell
+ * with the current weights:
+ *
+ *      A_k(theta, phi) = sum_{r in k} w_r * N_Y * P_l^|m|(cos phi) * e^(i m theta)
+ *      Psi(layer, theta, phi) = sum_k R_k(layer) * A_k(theta, phi)
+ *
+ * Adding, removing, or reweighting a recipe thus costs only its own factors plus the
+ * pre-sum and combine. When the recipes are azimuthally and/or equatorially symmetric
+ * (see bakeRecipes()), the pre-sum and combine only visit the fundamental domain, i.e.
+ * the theta = 0 column and/or the rings with phi <= pi/2, and the remaining voxels are
+ * copied from their mirror images. The combine pass costs one complex multiply-add per unique (n,l)
+ * at each voxel, with no recurrences or transcendentals. Table-build (including the
+ * pre-sum) and combine times are reported in cm_times[2] and [3].
+ *
+ * @param recipes The flattened recipes from bakeRecipes().
+ */
+void CloudManager::bakeTables(const BakeRecipes &recipes) {
+    steady_clock::time_point begin = steady_clock::now();
+
+    int div_local = this->cloudLayerDivisor;
+    int phi_max_local = this->cloudResolution >> 1;
+    int layer_size = this->cloudResolution * phi_max_local;
+    double pdv_4pi = (recipes.total_l) ? 1.0 : (4.0 * M_PI);
+
+    // Fundamental domain: theta column 0 if azimuthal, rings up to the equator if equatorial
+    bool azimuthal = recipes.azimuthal;
+    bool equatorial = recipes.equatorial;
+    int phi_half = phi_max_local >> 1;
+    auto fundamental = [azimuthal, equatorial, phi_max_local, phi_half](int cell) {
+        return !(azimuthal && (cell / phi_max_local)) && !(equatorial && ((cell % phi_max_local) > phi_half));
+    };
+
+    /*  Tables -- Fetch or bake every recipe's radial and angular factors  */
+    this->bakeFields(recipes);
+    if (this->cancelled()) {
+        return;
+    }
+
+    /*  Grouping -- unique (n,l) for radial terms  */
+    std::vector<int> radKeys;
+    std::vector<int> radIdx(recipes.count);
+    std::vector<const std::complex<double> *> angFields(recipes.count);
+    for (int r = 0; r < recipes.count; r++) {
+        int key = DSQ(recipes.ns[r], recipes.ls[r]);
+        auto it = std::find(radKeys.begin(), radKeys.end(), key);
+        radIdx[r] = int(it - radKeys.begin());
+        if (it == radKeys.end()) {
+            radKeys.push_back(key);
+        }
+        angFields[r] = &this->fieldCache.angular.at(DSQ(recipes.ls[r], recipes.ms[r]))[0];
+    }
+    int numRad = int(radKeys.size());
+    std::vector<const double *> radCols(numRad);
+    for (int k = 0; k < numRad; k++) {
+        radCols[k] = &this->fieldCache.radial.at(radKeys[k])[0];
+    }
+
+    /*  Tables -- Angular [theta*phi][nl], pre-summed over all recipes sharing an (n,l)  */
+    std::vector<std::complex<double>> angTable(layer_size * numRad);
+    std::vector<int> cells(layer_size);
+    std::iota(cells.begin(), cells.end(), 0);
+    const dvec *ws = &recipes.ws;
+    std::for_each(std::execution::par_unseq, cells.begin(), cells.end(),
+        [&angTable, &angFields, &radIdx, &fundamental, ws, numRad](int cell) {
+            if (!fundamental(cell)) {
+                return;
+            }
+            std::complex<double> *A = &angTable[cell * numRad];
+            for (size_t r = 0; r < radIdx.size(); r++) {
+                A[radIdx[r]] += angFields[r][cell] * (*ws)[r];
+            }
+        });
+
+    steady_clock::time_point tables = steady_clock::now();
+    cm_times[2] = std::chrono::duration<double, std::milli>(tables - begin).count();
+
+    /*  Combine -- Psi = sum_k R_k * A_k per voxel  */
+    auto combine = [&radCols, &angTable, numRad, div_local, pdv_4pi](int layer, int cell) {
+        const std::complex<double> *A = &angTable[cell * numRad];
+        std::complex<double> Psi;
+
+        for (int k = 0; k < numRad; k++) {
+            Psi += radCols[k][layer] * A[k];
+        }
+
+        double radius = static_cast<double>(layer + 1) / div_local;
+        return std::norm(Psi) * radius * radius * pdv_4pi;
+    };
+    float *dataStart = &this->allData[0];
+    double *maxStart = &this->layerMax[0];
+
+    if (!azimuthal && !equatorial) {
+        this->forEachLayer(
+            [this, &combine, dataStart, maxStart, layer_size](int layer) {
+                if (this->cancelled()) {
+                    return;
+                }
+                float *block = dataStart + (size_t(layer) * layer_size);
+                double blockMax = 0.0;
+                for (int cell = 0; cell < layer_size; cell++) {
+                    double pdv = combine(layer, cell);
+                    block[cell] = static_cast<float>(pdv);
+                    blockMax = std::max(blockMax, pdv);
+                }
+                maxStart[layer] = blockMax;
+                this->advance(layer_size);
+            });
+    } else {
+        // Evaluate the fundamental domain only, writing each result to all of its symmetric images
+        int theta_max_local = this->cloudResolution;
+        std::vector<int> fundCells;
+        for (int cell = 0; cell < layer_size; cell++) {
+            if (fundamental(cell)) {
+                fundCells.push_back(cell);
+            }
+        }
+        this->forEachLayer(
+            [this, &combine, &fundCells, dataStart, maxStart, layer_size, theta_max_local, phi_max_local, azimuthal, equatorial](int layer) {
+                if (this->cancelled()) {
+                    return;
+                }
+                float *block = dataStart + (size_t(layer) * layer_size);
+                double blockMax = 0.0;
+                for (int cell : fundCells) {
+                    double pdv = combine(layer, cell);
+                    float pdvf = static_cast<float>(pdv);
+                    blockMax = std::max(blockMax, pdv);
+
+                    int t = cell / phi_max_local;
+                    int p = cell % phi_max_local;
+                    int pMirror = phi_max_local - p;
+                    bool mirror = equatorial && p && (pMirror != p);
+                    int tEnd = (azimuthal) ? theta_max_local : (t + 1);
+                    for (int tImg = (azimuthal) ? 0 : t; tImg < tEnd; tImg++) {
+                        block[(tImg * phi_max_local) + p] = pdvf;
+                        if (mirror) {
+                            block[(tImg * phi_max_local) + pMirror] = pdvf;
+                        }
+                    }
+                }
+                maxStart[layer] = blockMax;
+                this->advance(layer_size);
+            });
+    }
+
+    this->trimFieldCache();
+
+    steady_clock::time_point end = steady_clock::now();
+    cm_times[3] = std::chrono::duration<double, std::milli>(end - tables).count();
+}
+
+/**
+ * @brief Ensure fieldCache holds the radial and angular factors of every recipe.
+ *
+ * @details
+ * The cache is flushed if the grid (resolution, divisor, or layer count) has changed
+ * since it was filled. Factors already present are only stamped as used. The missing
+ * radial columns are tabulated with the batch kernels, once per unique (n,l) across all
+ * layers. For the missing angular fields, the Legendre terms are tabulated once per unique
+ * (l,|m|) across all phi rings, or in BakeMode::RING_TABLES from a single all-degree sweep
+ * per phi ring, which fills every P_l^m (l <= L_max) in O(L_max^2). Each field is then
+ * expanded over the (theta, phi) cells with its exponential and normalization constant.
+ *
+ * If the request is cancelled, the angular fields not yet expanded are removed from the
+ * cache again, so it only ever holds complete factors.
+ *
+ * @param recipes The flattened recipes from bakeRecipes().
+ */
+void CloudManager::bakeFields(const BakeRecipes &recipes) {
+    int div_local = this->cloudLayerDivisor;
+    int theta_max_local = this->cloudResolution;
+    int phi_max_local = this->cloudResolution >> 1;
+    int layer_size = theta_max_local * phi_max_local;
+    int layer_max = this->opt_max_radius;
+    double deg_fac_local = this->deg_fac;
+    FieldCache &fc = this->fieldCache;
+
+    ivec3 grid(this->cloudResolution, div_local, layer_max);
+    if (fc.grid != grid) {
+        this->flushFieldCache();
+        fc.grid = grid;
+    }
+    uint64_t stamp = ++fc.stamp;
+
+    /*  Grouping -- factors missing from the cache  */
+    std::vector<ivec2> radKeys, angKeys;
+    for (int r = 0; r < recipes.count; r++) {
+        int n = recipes.ns[r];
+        int l = recipes.ls[r];
+        int m_l = recipes.ms[r];
+        int radKey = DSQ(n, l);
+        int angKey = DSQ(l, m_l);
+
+        if (!fc.radial.contains(radKey)) {
+            fc.radial[radKey].assign(layer_max, 0.0);
+            fc.bytes += layer_max * sizeof(double);
+            radKeys.push_back(ivec2(n, l));
+        }
+        if (!fc.angular.contains(angKey)) {
+            fc.angular[angKey].assign(layer_size, 0.0);
+            fc.bytes += layer_size * sizeof(std::complex<double>);
+            angKeys.push_back(ivec2(l, m_l));
+        }
+        fc.radialUse[radKey] = stamp;
+        fc.angularUse[angKey] = stamp;
+    }
+    int numRad = int(radKeys.size());
+    int numAng = int(angKeys.size());
+
+    // Bytes of the fields this bake reads, measured for the estimator
+    for (auto const &[key, use] : fc.radialUse) {
+        this->bakeFieldBytes += (use == stamp) ? fc.radial.at(key).size() * sizeof(double) : 0;
+    }
+    for (auto const &[key, use] : fc.angularUse) {
+        this->bakeFieldBytes += (use == stamp) ? fc.angular.at(key).size() * sizeof(std::complex<double>) : 0;
+    }
+
+    /*  Tables -- Radial [layer], one batch per (n,l), including radial norm  */
+    if (numRad) {
+        dvec radii(layer_max, 0.0);
+        for (int layer = 0; layer < layer_max; layer++) {
+            radii[layer] = static_cast<double>(layer + 1) / div_local;
+        }
+        std::for_each(std::execution::par, radKeys.begin(), radKeys.end(),
+            [this, &fc, &radii](const ivec2 &key) {
+                this->wavefuncRadialBatch(key.x, key.y, radii, &fc.radial.at(DSQ(key.x, key.y))[0]);
+            });
+    }
+
+    if (!numAng) {
+        return;
+    }
+
+    /*  Tables -- Legendre, either one batch per (l,|m|) [key][phi], or one all-degree sweep per ring [phi][l,m]  */
+    dvec cosPhis(phi_max_local, 0.0);
+    for (int p = 0; p < phi_max_local; p++) {
+        cosPhis[p] = cos(p * deg_fac_local);
+    }
+    dvec legTable;
+    std::vector<int> legIdx(numAng);
+    int legStrideKey = phi_max_local;
+    int legStridePhi = 1;
+    if (this->bakeMode == BakeMode::RING_TABLES) {
+        int l_max = std::max_element(angKeys.cbegin(), angKeys.cend(), [](const ivec2 &a, const ivec2 &b) { return a.x < b.x; })->x;
+        int triSize = atomix::special::atomix_legendre_size(l_max);
+        legStrideKey = 1;
+        legStridePhi = triSize;
+        for (int k = 0; k < numAng; k++) {
+            legIdx[k] = atomix::special::atomix_legendre_idx(angKeys[k].x, std::abs(angKeys[k].y));
+        }
+
+        legTable.assign(phi_max_local * triSize, 0.0);
+        std::vector<int> legRings(phi_max_local);
+        std::iota(legRings.begin(), legRings.end(), 0);
+        std::for_each(std::execution::par, legRings.begin(), legRings.end(),
+            [&cosPhis, &legTable, l_max, triSize](int p) {
+                atomix::special::atomix_legendre_all(l_max, cosPhis[p], &legTable[p * triSize]);
+            });
+    } else {
+        legTable.assign(numAng * phi_max_local, 0.0);
+        std::iota(legIdx.begin(), legIdx.end(), 0);
+        std::vector<int> legCols(numAng);
+        std::iota(legCols.begin(), legCols.end(), 0);
+        std::for_each(std::execution::par, legCols.begin(), legCols.end(),
+            [this, &angKeys, &cosPhis, &legTable, phi_max_local](int k) {
+                this->wavefuncAngLegBatch(angKeys[k].x, angKeys[k].y, cosPhis, &legTable[k * phi_max_local]);
+            });
+    }
+
+    /*  Tables -- Angular fields [theta*phi] per (l,m), with exponential and angular norm  */
+    for (int k = 0; k < numAng; k++) {
+        if (this->cancelled()) {
+            for (int j = k; j < numAng; j++) {
+                int angKey = DSQ(angKeys[j].x, angKeys[j].y);
+                fc.bytes -= fc.angular.at(angKey).size() * sizeof(std::complex<double>);
+                fc.angular.erase(angKey);
+                fc.angularUse.erase(angKey);
+            }
+            return;
+        }
+
+        int l = angKeys[k].x;
+        int m_l = angKeys[k].y;
+        double angNorm = atomix::orbitals::norm_angular(l, m_l);
+        std::vector<std::complex<double>> expCol(theta_max_local);
+        for (int t = 0; t < theta_max_local; t++) {
+            expCol[t] = std::polar(angNorm, m_l * (t * deg_fac_local));
+        }
+
+        std::vector<std::complex<double>> &field = fc.angular.at(DSQ(l, m_l));
+        std::complex<double> *fieldStart = &field[0];
+        const double *leg = &legTable[legIdx[k] * legStrideKey];
+        std::for_each(std::execution::par_unseq, field.begin(), field.end(),
+            [&expCol, fieldStart, leg, phi_max_local, legStridePhi](std::complex<double> &item) {
+                int cell = int(&item - fieldStart);
+                int t = cell / phi_max_local;
+                int p = cell % phi_max_local;
+                item = expCol[t] * leg[p * legStridePhi];
+            });
+    }
+}
+
+/**
+ * @brief Evict the least recently used factors from fieldCache until it fits the budget.
+ *
+ * @details
+ * Factors used by the current recipes are evicted last, and only if they alone exceed
+ * `fieldCacheBudget`, in which case the next edit rebakes them.
+ */
+void CloudManager::trimFieldCache() {
+    FieldCache &fc = this->fieldCache;
+    if (fc.bytes <= this->fieldCacheBudget) {
+        return;
+    }
+
+    // (lastUse, key, isAngular) -- oldest first
+    std::vector<std::tuple<uint64_t, int, bool>> entries;
+    for (auto const &[key, use] : fc.radialUse) {
+        entries.emplace_back(use, key, false);
+    }
+    for (auto const &[key, use] : fc.angularUse) {
+        entries.emplace_back(use, key, true);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    for (auto const &[use, key, isAngular] : entries) {
+        if (fc.bytes <= this->fieldCacheBudget) {
+            break;
+        }
+        if (isAngular) {
+            fc.bytes -= fc.angular.at(key).size() * sizeof(std::complex<double>);
+            fc.angular.erase(key);
+            fc.angularUse.erase(key);
+        } else {
+            fc.bytes -= fc.radial.at(key).size() * sizeof(double);
+            fc.radial.erase(key);
+            fc.radialUse.erase(key);
+        }
+    }
+}
+
+/**
+ * @brief Discard all cached orbital factors.
+ */
+void CloudManager::flushFieldCache() {
+    this->fieldCache.radial.clear();
+    this->fieldCache.angular.clear();
+    this->fieldCache.radialUse.clear();
+    this->fieldCache.angularUse.clear();
+    this->fieldCache.grid = ivec3(0);
+    this->fieldCache.bytes = 0;
+}
+
+/**
+ * @brief Set all PDVs below the tolerance to zero, and store indices of non-zero PDVs in idxCulledTolerance.
+ *
+ * @details
+ * A PDV has been generated for every vertex in the mesh. This function culls all PDVs
+ * below the tolerance and stores the indices of non-zero PDVs in idxCulledTolerance
+ * in order to greatly reduce the size of the data buffer and the number of vertices
+ * that need to be rendered.
+ *
+ * By default the survivors are compacted in voxel order by compactAbove(). With the
+ * tolerance index enabled (setToleranceIndex()), every re-cull of the same bake instead
+ * takes a prefix of the PDV-sorted index, and the survivors come out in descending PDV
+ * order; see cullToleranceIndexed().
+ * 
+ * This function is a parallelized version of cullTolerance().
+ *
+ * @return The time taken to complete the function in milliseconds.
+ */
+double CloudManager::cullToleranceThreaded() {
+    if (this->cancelled()) {
+        return 0.0;
+    }
+    assert(mStatus.hasFirstNotLast(em::DATA_READY, em::INDEX_GEN));
+    cm_proc_fine.lock();
+    steady_clock::time_point begin = steady_clock::now();
+    this->beginStage(BakeStage::CULL, this->pixelCount);
 
-    /*  Compute -- Begin --- This compute portion takes only 6% of create() total time  */
-    // auto beginInner = steady_clock::now();
-    vec4 *start = &this->allVertices.at(0);
-    std::for_each(std::execution::par_unseq, allVertices.begin(), allVertices.end(),
-        [layer_size, phi_max_local, deg_fac_local, div_local, start, isGPU](glm::vec4 &gVector){
-            int i = int(&gVector - start);
-            int layer = (i / layer_size) + 1;
-            int layer_pos = i % layer_size;
-            float theta = (layer_pos / phi_max_local) * deg_fac_local;
-            float phi = (layer_pos % phi_max_local) * deg_fac_local;
-            float radius = static_cast<float>(layer) / div_local;
+    // The index is only worth sorting once the same bake is re-culled, so the first cull always scans
+    if (this->toleranceIndex && (this->pdvOrderValid || this->bakeCulled)) {
+        this->cullToleranceIndexed();
+    } else {
+        this->compactAbove(this->cloudTolerance, this->idxCulledTolerance);
+        this->idxIsPdvPrefix = false;
+    }
+    this->bakeCulled = true;
+    this->advance(this->pixelCount - std::min(this->pixelCount, this->progressDone.load(std::memory_order_relaxed)));
 
-            if (isGPU) {
-                gVector.x = radius;
-                gVector.y = theta;
-                gVector.z = phi;
-            } else {
-                gVector.x = radius * sin(phi) * sin(theta);
-                gVector.y = radius * cos(phi);
-                gVector.z = radius * sin(phi) * cos(theta);
-            }
-        });
-    // auto endInner = steady_clock::now();
-    // auto createTime = std::chrono::duration<double, std::milli>(endInner - beginInner).count();
-    // std::cout << "Create Inner Loop took: " << createTime << " ms" << std::endl;
+    // Our model now displays cm_pixels count of indices/vertices unless culled by slider
+    this->cm_pixels = idxCulledTolerance.size();
+    if (!this->idxIsPdvPrefix || !this->iboHoldsPdvOrder) {
+        reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
+        allIndices.reserve(this->cm_pixels);
+    }
+    this->iboHoldsTolerance = false;
 
     /*  Exit  */
-    mStatus.set(em::VERT_READY);
-    genVertexArray();
+    mStatus.set(em::INDEX_GEN);
     steady_clock::time_point end = steady_clock::now();
     cm_proc_fine.unlock();
     return (std::chrono::duration<double, std::milli>(end - begin).count());
 }
 
 /**
- * @brief Generates the cloud data for the given orbital recipes using threads.
+ * @brief Compact the indices of all voxels with a PDV above `threshold`, in voxel order.
  *
  * @details
- * This function is the threaded version of bakeOrbitals(). It is the most time-
- * consuming part of the cloud rendering process. The function first groups the
- * orbital recipes by N and then iterates over each group, calling a lambda function
- * for each recipe. The lambda function generates the cloud data for each orbital and
- * stores it in the dataStaging vector. The final maximum value of the accumulated
- * vector is stored in allPDVMaximum. The function then populates allData with the
- * normalized PDVs [** as FLOATS **] and leaves dataStaging untouched. Finally, the
- * function clears the dataStaging vector and sets the `em::DATA_READY` status.
+ * Each layer's visible count (taken from the bake when it already counted at this
+ * threshold) is prefix-summed into an output offset, and each layer then writes its
+ * indices directly into place. Only the visible indices are ever allocated.
  *
- * @return The time taken to complete the function in milliseconds.
+ * @param threshold The normalized PDV a voxel must exceed.
+ * @param[out] out The compacted indices.
  */
-double CloudManager::bakeOrbitalsThreaded() {
-    assert(mStatus.hasFirstNotLast(em::VERT_READY, em::DATA_READY));
-    cm_proc_fine.lock();
-    steady_clock::time_point begin = steady_clock::now();
-
-    /*  Prep -- Compute  */
-    int numRecipes = this->countMapRecipes(&cloudOrbitals);
-    std::vector<int> ns(numRecipes, 0);
-    std::vector<int> ls(numRecipes, 0);
-    std::vector<int> ms(numRecipes, 0);
-    std::vector<double> ws(numRecipes, 0.0);
-    std::vector<double> ny(numRecipes, 0.0);
-    std::vector<double> nr(numRecipes, 0.0);
-    int rIdx = 0;
-    for (auto const &[key, val] : cloudOrbitals) {
-        for (auto const &v : val) {
-            ns[rIdx] = key;
-            ls[rIdx] = v.x;
-            ms[rIdx] = v.y;
-            ws[rIdx] = v.z;
-            ny[rIdx] = this->norm_constY[DSQ(v.x, v.y)];
-            nr[rIdx] = this->norm_constR[DSQ(key, v.x)];
-            rIdx++;
-        }
+void CloudManager::compactAbove(float threshold, uvec &out) {
+    int layer_size = this->cloudResolution * (this->cloudResolution >> 1);
+    const float *dataStart = &allData[0];
+    size_t numLayers = this->opt_max_radius;
+
+    // Count visible voxels per layer, unless the bake already did so for this threshold
+    if ((this->countedTolerance != threshold) || (this->layerCounts.size() != numLayers)) {
+        this->layerCounts.assign(numLayers, 0);
+        uint *countStart = &layerCounts[0];
+        this->forEachLayer(
+            [dataStart, countStart, layer_size, threshold](int layer) {
+                const float *block = dataStart + (size_t(layer) * layer_size);
+                countStart[layer] = uint(std::count_if(block, block + layer_size, [threshold](float pdv) {
+                    return pdv > threshold;
+                }));
+            });
+        this->countedTolerance = threshold;
     }
-    double weightSum = std::accumulate(ws.cbegin(), ws.cend(), 0.0);
-    std::for_each(std::execution::par_unseq, ws.begin(), ws.end(), [&](double &weight) {
-        weight /= weightSum;
-    });
-    dvec *dataStagingPtr = &this->dataStaging;
-
 
-    /*  Compute -- Begin
-        This section contains 62%-98% of the total execution time of cloud generation,
-        which can easily scale into Ne+1 minutes for high resolutions. For that reason,
-        I'm unrolling all the pretty functions that go into this calc (hyperoptimization).
-    */
-    // steady_clock::time_point inner_begin = steady_clock::now();
-    vec4 *vertStart = &this->allVertices[0];
-    std::for_each(std::execution::par_unseq, allVertices.begin(), allVertices.end(),
-        [&ns, &ls, &ms, &ws, &ny, &nr, dataStagingPtr, numRecipes, vertStart](vec4 &item) {
-            uint idx = uint(&item - vertStart);
-            std::complex<double> Psi;
-            double radius = item.x;
-            double theta = item.y;
-            double phi = item.z;
-            double pdv = 0.0;
-            double pdv_factor = radius * radius;
-            int total_l = 0;
-
-            // Recipe Loop
-            for (int r = 0; r < numRecipes; r++) {
-                int n = ns[r];
-                int l = ls[r];
-                int m_l = ms[r];
-                double angNorm = ny[r];
-                double radNorm = nr[r];
-                double weight = ws[r];
-                total_l += l;
-            
-                // Radial wavefunc
-                double rho = 2.0 * radius / static_cast<double>(n);
-                double rhol = 1.0;
-                    // (exponential subroutine for rho^l to avoid time cost of pow())
-                for (int l_times = l; l_times > 0; l_times--) {
-                    rhol *= rho;
+    // Prefix-sum the counts into each layer's output offset, then compact visible indices straight into place
+    uvec offsets(numLayers, 0);
+    std::exclusive_scan(std::execution::par, layerCounts.cbegin(), layerCounts.cend(), offsets.begin(), 0u);
+    size_t visible = (!numLayers) ? 0 : (size_t(offsets.back()) + layerCounts.back());
+    out.clear();
+    out.resize(visible);
+
+    uint *idxStart = (visible) ? &out[0] : nullptr;
+    const uint *offsetStart = &offsets[0];
+    this->forEachLayer(
+        [this, dataStart, idxStart, offsetStart, layer_size, threshold](int layer) {
+            uint base = uint(layer) * layer_size;
+            uint *dst = idxStart + offsetStart[layer];
+            for (int i = 0; i < layer_size; i++) {
+                if (dataStart[base + i] > threshold) {
+                    *dst++ = base + i;
                 }
-                double R = lagp((n - l - 1), ((l << 1) + 1), rho) * rhol * exp(-rho * 0.5) * radNorm;
-
-                // Angular wavefunc
-                std::complex<double> Y = exp(std::complex<double>{0,1} * (m_l * theta)) * angNorm * legp(l, abs(m_l), cos(phi));
-                Psi += R * Y * weight;
             }
+            this->advance(layer_size);
+        });
+}
 
-            if (!total_l) {
-                pdv_factor *= 4.0 * M_PI;
-            }
-            pdv = (std::conj(Psi) * Psi).real() * pdv_factor;
-            (*dataStagingPtr)[idx] += pdv;
-
-        }); // End of Lambda
+/**
+ * @brief Cull to the current tolerance as a prefix of the PDV-sorted tolerance index.
+ *
+ * @details
+ * The first re-cull of a bake orders every voxel above `indexFloor` by descending PDV
+ * into pdvOrder, sorting packed (PDV, index) keys so the sort never chases pointers
+ * into allData. From then on, the visible set for any tolerance >= indexFloor is the
+ * prefix of pdvOrder found by binary search, and idxCulledTolerance is grown or shrunk
+ * to it, so a tolerance change costs time proportional to the number of voxels it adds
+ * or drops. Tolerances below the floor rebuild the index with a lower floor.
+ *
+ * While the sliders are untouched, the IBO holds all of pdvOrder, uploaded once per index
+ * build, and the visible set is drawn as its prefix (cullSliderThreaded()).
+ */
+void CloudManager::cullToleranceIndexed() {
+    const float tolerance_local = this->cloudTolerance;
+    const float *dataStart = &allData[0];
 
-    /*  Compute -- Post-processing  */
-    // Check actual max value of accumulated vector
-    this->allPDVMaximum = *std::max_element(std::execution::par, dataStaging.begin(), dataStaging.end());
+    if (!this->pdvOrderValid || (tolerance_local < this->indexFloor)) {
+        this->indexFloor = std::min(tolerance_local, TOLERANCE_INDEX_FLOOR);
+        this->compactAbove(this->indexFloor, this->pdvOrder);
 
-    // Normalize PDVs againt Maximum and populate allData with results [** as FLOATS **], leaving dataStaging untouched
-    double pdvMax = this->allPDVMaximum;
-    std::transform(std::execution::par_unseq, dataStaging.cbegin(), dataStaging.cend(), allData.begin(),
-        [pdvMax](const double &item){
-            return static_cast<float>(item / pdvMax);
+        // Positive floats order like their bit patterns, so inverted bits in the high word sort by descending PDV
+        std::vector<uint64_t> keys(pdvOrder.size());
+        std::transform(std::execution::par_unseq, pdvOrder.cbegin(), pdvOrder.cend(), keys.begin(), [dataStart](uint idx) {
+            return (uint64_t(~std::bit_cast<uint32_t>(dataStart[idx])) << 32) | idx;
         });
+        std::sort(std::execution::par_unseq, keys.begin(), keys.end());
+        std::transform(std::execution::par_unseq, keys.cbegin(), keys.cend(), pdvOrder.begin(), [](uint64_t key) {
+            return uint(key);
+        });
+        this->pdvOrderValid = true;
+        this->idxIsPdvPrefix = false;
+        this->iboHoldsPdvOrder = false;
+    }
+    if (!this->idxIsPdvPrefix) {
+        idxCulledTolerance.clear();
+        this->idxIsPdvPrefix = true;
+    }
 
-    /*  Cleanup  */
-    dataStaging.clear();
-    
-    /*  Exit  */
-    mStatus.set(em::DATA_READY);
-    genDataBuffer();
-    steady_clock::time_point end = steady_clock::now();
-    cm_proc_fine.unlock();
-    return (std::chrono::duration<double, std::milli>(end - begin).count());
+    size_t visible = size_t(std::partition_point(pdvOrder.cbegin(), pdvOrder.cend(), [dataStart, tolerance_local](uint idx) {
+        return dataStart[idx] > tolerance_local;
+    }) - pdvOrder.cbegin());
+    size_t current = idxCulledTolerance.size();
+
+    if (visible > current) {
+        idxCulledTolerance.insert(idxCulledTolerance.end(), pdvOrder.cbegin() + current, pdvOrder.cbegin() + visible);
+    } else {
+        idxCulledTolerance.resize(visible);
+    }
 }
 
 /**
- * @brief Set all PDVs below the tolerance to zero, and store indices of non-zero PDVs in idxCulledTolerance.
+ * @brief Fill the PDVs and tolerance-culled indices from the on-disk cache, skipping the bake.
  *
  * @details
- * A PDV has been generated for every vertex in the mesh. This function culls all PDVs
- * below the tolerance and stores the indices of non-zero PDVs in idxCulledTolerance
- * in order to greatly reduce the size of the data buffer and the number of vertices
- * that need to be rendered.
- * 
- * This function is a parallelized version of cullTolerance().
+ * Looks up the current config, layer count, and recipes in `diskCache`, which only returns
+ * entries whose indices all lie within their PDVs. On a hit, the mapped PDVs and indices
+ * are copied into allData and idxCulledTolerance, and the manager is left in the same state
+ * as after bakeOrbitalsThreaded() and cullToleranceThreaded().
  *
- * @return The time taken to complete the function in milliseconds.
+ * @return True on a cache hit, False if the cloud must be baked.
  */
-double CloudManager::cullToleranceThreaded() {
-    assert(mStatus.hasFirstNotLast(em::DATA_READY, em::INDEX_GEN));
+bool CloudManager::loadCachedCloud() {
+    if (this->cancelled()) {
+        return false;
+    }
+    assert(mStatus.hasFirstNotLast(em::VERT_READY, em::DATA_READY));
+    if (!this->diskCache.enabled()) {
+        return false;
+    }
     cm_proc_fine.lock();
     steady_clock::time_point begin = steady_clock::now();
-    idxCulledTolerance.resize(this->dataCount);
-    idxCulledTolerance.assign(this->dataCount, 0);
 
-    /* The joys of debugging segfaults and exceptions in asynchronous, non-static, Filter and Map functions called via lambdas. */
-
-    // Populate idxCulledTolerance with visible indices based on Tolerance, leaving allData untouched for future Tolerance tests
-    const float *vecStart = &allData[0];
-    const float tolerance_local = this->cloudTolerance;
-    std::transform(std::execution::par_unseq, allData.cbegin(), allData.cend(), idxCulledTolerance.begin(),
-        [tolerance_local, vecStart](const float &item){
-            uint idx = uint(&item - vecStart);
-            return (item > tolerance_local) ? idx : 0u;
-        });
+    CloudCacheEntry entry;
+    uint64_t key = CloudCache::makeKey(this->cfg, this->opt_max_radius, this->cloudOrbitals);
+    if (!this->diskCache.load(key, entry) || (entry.header->dataCount != this->pixelCount)) {
+        this->diskCache.release();
+        cm_proc_fine.unlock();
+        return false;
+    }
 
-    // Isolate unused indices for easy removal, then remove them
-    auto itEnd = std::remove_if(std::execution::par_unseq, idxCulledTolerance.begin(), idxCulledTolerance.end(),
-        [](uint &item){
-            return !item;
-        });
-    idxCulledTolerance.erase(itEnd, idxCulledTolerance.end());
+    // Copy by layer, so each layer's pages are first touched on the node that will process them
+    reclaimBuffer(this->allData, this->dataLoan, this->snapPublished.dataData);
+    this->sizeBuffer(this->allData, this->pixelCount);
+    int layer_size = this->cloudResolution * (this->cloudResolution >> 1);
+    const float *cacheStart = entry.data;
+    float *dataStart = &this->allData[0];
+    this->forEachLayer([cacheStart, dataStart, layer_size](int layer) {
+        size_t base = size_t(layer) * layer_size;
+        std::copy(cacheStart + base, cacheStart + base + layer_size, dataStart + base);
+    });
+    this->idxCulledTolerance.assign(entry.indices, entry.indices + entry.header->indexCount);
+    this->allPDVMaximum = entry.header->pdvMax;
+    this->countedTolerance = -1.0f;
+    this->pdvOrderValid = false;
+    this->idxIsPdvPrefix = false;
+    this->bakeCulled = true;
+    this->iboHoldsTolerance = false;
+    this->iboHoldsPdvOrder = false;
+    this->diskCache.release();
 
-    // Our model now displays cm_pixels count of indices/vertices unless culled by slider
     this->cm_pixels = idxCulledTolerance.size();
+    reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
     allIndices.reserve(this->cm_pixels);
 
     /*  Exit  */
-    mStatus.set(em::INDEX_GEN);
+    mStatus.set(em::DATA_READY | em::INDEX_GEN);
+    genDataBuffer();
     steady_clock::time_point end = steady_clock::now();
+    cm_times[1] = std::chrono::duration<double, std::milli>(end - begin).count();
+    cm_times[2] = cm_times[3] = cm_times[4] = 0.0;
     cm_proc_fine.unlock();
-    return (std::chrono::duration<double, std::milli>(end - begin).count());
+    return true;
+}
+
+/**
+ * @brief Write the freshly baked and tolerance-culled cloud to the on-disk cache.
+ */
+void CloudManager::storeCachedCloud() {
+    if (this->cancelled()) {
+        return;
+    }
+    assert(mStatus.hasAll(em::DATA_READY | em::INDEX_GEN));
+    if (!this->diskCache.enabled()) {
+        return;
+    }
+    cm_proc_fine.lock();
+    uint64_t key = CloudCache::makeKey(this->cfg, this->opt_max_radius, this->cloudOrbitals);
+    this->diskCache.store(key, this->allPDVMaximum, this->allData, this->idxCulledTolerance);
+    cm_proc_fine.unlock();
+}
+
+/**
+ * @brief Write the current bake to `path` in the disk cache format (see CloudCache).
+ *
+ * @details
+ * The file is keyed as storeCachedCloud() would key it, so it can be copied into a
+ * cache directory as-is.
+ *
+ * @param path The file to write.
+ * @return True if a finished bake was written.
+ */
+bool CloudManager::exportCloud(const std::string &path) {
+    std::lock_guard<std::mutex> guard(cm_proc_coarse);
+    if (!mStatus.hasAll(em::DATA_READY | em::INDEX_GEN) || this->hasRefinement()) {
+        return false;
+    }
+    uint64_t key = CloudCache::makeKey(this->cfg, this->opt_max_radius, this->cloudOrbitals);
+    return CloudCache::writeFile(path, key, this->allPDVMaximum, this->allData, this->idxCulledTolerance);
 }
 
 /**
@@ -467,8 +1665,12 @@ double CloudManager::cullToleranceThreaded() {
  * @return The time taken to complete the function in milliseconds.
  */
 double CloudManager::expandPDVsToColours() {
-    allColours.resize(allVertices.size());
-    allColours.assign(allVertices.size(), vec4(0.0f));
+    if (this->cancelled()) {
+        return 0.0;
+    }
+    reclaimBuffer(allColours, colourLoan, snapPublished.colourData);
+    allColours.resize(this->pixelCount);
+    allColours.assign(this->pixelCount, vec4(0.0f));
 
     vec4 colours[11] = {
         vec4(2.0f, 0.0f, 2.0f, 1.0f),      // [0-9%] -- Magenta
@@ -504,12 +1706,24 @@ double CloudManager::expandPDVsToColours() {
  * @details
  * This function is a parallelized version of `cullSlider()`.
  *
+ * Vertices are laid out layer-major, then theta, then phi, so the slider culls leave at
+ * most one contiguous run of phi per (layer, theta) row. While idxCulledTolerance is in
+ * voxel order, the IBO therefore holds it unchanged and the sliders only produce a list
+ * of draw ranges into it (genSliderRanges()), so dragging them neither rebuilds nor
+ * re-uploads the IBO. A PDV-ordered list (setToleranceIndex()) is a prefix of pdvOrder,
+ * so with the sliders untouched the IBO holds all of pdvOrder and only its draw count
+ * follows the tolerance. With the sliders culling, a PDV-ordered list is compacted by filter.
+ *
  * @return The time taken to complete the function in milliseconds.
  */
 double CloudManager::cullSliderThreaded() {
+    if (this->cancelled()) {
+        return 0.0;
+    }
     assert(mStatus.hasFirstNotLast(em::INDEX_GEN, em::INDEX_READY));
     cm_proc_fine.lock();
     steady_clock::time_point begin = steady_clock::now();
+    this->beginStage(BakeStage::SLIDER, this->idxCulledTolerance.size());
 
     bool visible = !bool(int(this->cfg.cloudCull_x) + int(this->cfg.cloudCull_y) + int(this->cfg.cloudCull_rIn) + int(this->cfg.cloudCull_rOut));
     bool rin = (this->cfg.cloudCull_rIn);
@@ -517,79 +1731,191 @@ double CloudManager::cullSliderThreaded() {
     bool radial = (rin || rout);
     bool angular = ((this->cfg.cloudCull_x) || (this->cfg.cloudCull_y));
     bool untouched  = !(angular || radial);
+    bool prefix = (this->idxIsPdvPrefix && untouched);
+    bool upload = (prefix) ? !this->iboHoldsPdvOrder : !this->iboHoldsTolerance;
 
-    uint radial_layers = this->opt_max_radius;
-    if (radial) {
-        radial_layers *= (rin) ? (1.0f - this->cfg.cloudCull_rIn) : this->cfg.cloudCull_rOut;
-    }
-    uint64_t rad_threshold = radial_layers * this->cloudResolution * (this->cloudResolution >> 1);
+    SliderCull cull = sliderBounds(this->cfg, this->cloudResolution, this->opt_max_radius);
 
+    drawRanges.clear();
     if (visible) {
-        if (untouched) {
-            //  Default -- X/Y sliders are not culling, so copy idxCulledTolerance directly to allIndices! 
-            allIndices.resize(this->cm_pixels);
-            allIndices.assign(this->cm_pixels, 0);
-            std::copy(std::execution::par, idxCulledTolerance.cbegin(), idxCulledTolerance.cend(), allIndices.begin());
-            
-        } else {
-            //  Other -- X/Y sliders ARE culling, so count number of unculled vertices, resize allIndices, and then copy unculled vertices.  
-            uint layer_size = 0, culled_theta_all = 0, phi_size = 0, culled_phi_f = 0, culled_phi_b = 0;
-            float phi_front_pct = 0.0f, phi_back_pct = 0.0f;
-            layer_size = (this->cloudResolution * this->cloudResolution) >> 1;
-            culled_theta_all = static_cast<uint>(ceil(layer_size * this->cfg.cloudCull_x));
-            phi_size = this->cloudResolution >> 1;
-            if (this->cfg.cloudCull_y > 0.50f) {
-                phi_front_pct = 1.0f;
-                phi_back_pct = (this->cfg.cloudCull_y - 0.50f) * 2.0f;
-            } else {
-                phi_front_pct = this->cfg.cloudCull_y * 2.0f;
-                phi_back_pct = 0.0f;
+        if (prefix) {
+            //  PDV prefix -- The IBO holds all of pdvOrder, and only the first cm_pixels indices are drawn
+            if (upload) {
+                reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
+                allIndices.resize(pdvOrder.size());
+                std::copy(std::execution::par, pdvOrder.cbegin(), pdvOrder.cend(), allIndices.begin());
+                this->iboHoldsPdvOrder = true;
+                this->iboHoldsTolerance = false;
+            }
+
+        } else if (!this->idxIsPdvPrefix) {
+            //  Default -- The IBO holds idxCulledTolerance as-is, and any slider culling is drawn as ranges of it
+            if (upload) {
+                reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
+                allIndices.resize(this->cm_pixels);
+                std::copy(std::execution::par, idxCulledTolerance.cbegin(), idxCulledTolerance.cend(), allIndices.begin());
+                this->iboHoldsTolerance = true;
+                this->iboHoldsPdvOrder = false;
+            }
+            if (!untouched) {
+                genSliderRanges(cull, idxCulledTolerance.data(), idxCulledTolerance.data() + idxCulledTolerance.size(), drawRanges);
+                visible = !drawRanges.empty();
             }
-            culled_phi_f = static_cast<uint>(ceil(phi_size * phi_front_pct));
-            culled_phi_b = phi_size - static_cast<uint>(ceil(phi_size * phi_back_pct));
-
-            // Define lambda for multi-use
-            auto lambda_cull = [layer_size, culled_theta_all, phi_size, culled_phi_f, culled_phi_b, rad_threshold, rin, rout](const uint &item){
-                uint layer_pos = (item % layer_size);
-                uint theta_pos = layer_pos / phi_size;
-                uint phi_pos = item % phi_size;
-                bool culled_theta = (layer_pos <= culled_theta_all);
-                bool culled_theta_phis = (phi_pos <= phi_size);
-                bool culled_phi_front = (phi_pos <= culled_phi_f);
-                bool culld_phi_back = (phi_pos >= culled_phi_b);
-                bool culled_phi_thetas_front = (theta_pos <= phi_size);   // phi_size here is theta_size/2
-                bool culled_phi_thetas_back = (theta_pos > phi_size);   // phi_size here is theta_size/2
-                bool culled_radial_in = rin && (item > rad_threshold);
-                bool culled_radial_out = rout && (item < rad_threshold);
-
-                bool theta_culled = (culled_theta && culled_theta_phis);
-                bool phi_culled = (culled_phi_front && culled_phi_thetas_front) || (culld_phi_back && culled_phi_thetas_back);
-                bool radial_culled = (culled_radial_in || culled_radial_out);
-
-                return !(theta_culled || phi_culled || radial_culled);
+
+        } else {
+            //  PDV-ordered -- Sliders ARE culling, so count number of unculled vertices, resize allIndices, and then copy unculled vertices.  
+            auto lambda_cull = [cull](const uint &item){
+                uint layer_pos = (item % cull.layer_size);
+                uint theta_pos = layer_pos / cull.phi_size;
+                uint phi_pos = item % cull.phi_size;
+                bool phi_kept = (theta_pos <= cull.phi_size) ? (phi_pos >= cull.phi_front) : (phi_pos < cull.phi_back);   // phi_size here is theta_size/2
+
+                return (item >= cull.begin) && (item < cull.end) && (layer_pos >= cull.theta_all) && phi_kept;
             };
 
             // Count unculled vertices
             uint pix_final = std::count_if(std::execution::par_unseq, idxCulledTolerance.cbegin(), idxCulledTolerance.cend(), lambda_cull);
 
             // Resize allIndices. ***Note: resize does NOT change capacity, so full size is still reserved!
+            reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
             allIndices.resize(pix_final);
-            allIndices.assign(pix_final, 0);
 
             // Copy only unculled vertices to allIndices
             std::copy_if(std::execution::par_unseq, idxCulledTolerance.cbegin(), idxCulledTolerance.cend(), allIndices.begin(), lambda_cull);
+            this->iboHoldsTolerance = false;
+            this->iboHoldsPdvOrder = false;
+            upload = true;
         }
     }
 
     /*  Exit  */
-    mStatus.set(em::INDEX_READY);
-    genIndexBuffer();
+    mStatus.set(em::INDEX_READY | em::UPD_RANGES);
+    if (upload) {
+        genIndexBuffer();
+    } else {
+        // Same IBO contents, so only its draw count may need restoring after being hidden, or following the tolerance
+        this->indexCount = setIndexCount();
+        if (mStatus.hasNone(em::UPD_IBO)) {
+            mStatus.set(em::UPD_IDXOFF);
+        }
+    }
+    if (prefix) {
+        this->indexCount = this->cm_pixels;
+    }
     this->indexCount *= uint64_t(visible);
+    this->progressDone.fetch_add(this->idxCulledTolerance.size(), std::memory_order_relaxed);
     steady_clock::time_point end = steady_clock::now();
     cm_proc_fine.unlock();
     return std::chrono::duration<double, std::milli>(end - begin).count();
 }
 
+/**
+ * @brief Convert the slider positions of `config` to half-open cull bounds in voxel space.
+ *
+ * @param config The cloud config holding the slider positions.
+ * @param resolution The resolution of the vertex grid.
+ * @param layers The layers within the tolerance radius.
+ * @return The cull bounds.
+ */
+SliderCull CloudManager::sliderBounds(const AtomixCloudConfig &config, int resolution, uint layers) {
+    bool rin = (config.cloudCull_rIn);
+    bool rout = (config.cloudCull_rOut);
+
+    SliderCull cull;
+    cull.phi_size = resolution >> 1;
+    cull.layer_size = resolution * cull.phi_size;
+    cull.theta_all = static_cast<uint>(ceil(cull.layer_size * config.cloudCull_x));
+    float phi_front_pct = (config.cloudCull_y > 0.50f) ? 1.0f : (config.cloudCull_y * 2.0f);
+    float phi_back_pct = (config.cloudCull_y > 0.50f) ? ((config.cloudCull_y - 0.50f) * 2.0f) : 0.0f;
+    cull.phi_front = static_cast<uint>(ceil(cull.phi_size * phi_front_pct));
+    cull.phi_back = cull.phi_size - static_cast<uint>(ceil(cull.phi_size * phi_back_pct));
+
+    uint radial_layers = layers;
+    if (rin || rout) {
+        radial_layers *= (rin) ? (1.0f - config.cloudCull_rIn) : config.cloudCull_rOut;
+    }
+    uint64_t rad_threshold = uint64_t(radial_layers) * cull.layer_size;
+    cull.end = uint64_t(layers) * cull.layer_size;
+    if (rin) {
+        cull.end = rad_threshold;
+    }
+    if (rout) {
+        cull.begin = rad_threshold;
+    }
+    return cull;
+}
+
+/**
+ * @brief Express the slider culls as draw ranges into a voxel-ordered list of indices.
+ *
+ * @details
+ * Each (layer, theta) row within the radial bounds keeps one run of phi, which is mapped
+ * to a run of the list by binary search from the previous run's end. Runs that touch,
+ * either in voxel space or because no tolerance-surviving voxel lies between them, are
+ * merged, so unculled stretches of the cloud cost a single range.
+ *
+ * @param cull The slider culls, as half-open bounds in voxel space.
+ * @param idxBegin The start of the list, usually idxCulledTolerance.
+ * @param idxEnd The end of the list.
+ * @param[out] ranges The draw ranges, appended to.
+ */
+void CloudManager::genSliderRanges(const SliderCull &cull, const uint *idxBegin, const uint *idxEnd, std::vector<DrawRange> &ranges) {
+    const uint *cursor = idxBegin;
+
+    auto addRun = [&ranges, idxBegin, idxEnd, &cursor](uint64_t vox_begin, uint64_t vox_end) {
+        const uint *first = std::lower_bound(cursor, idxEnd, vox_begin);
+        const uint *last = std::lower_bound(first, idxEnd, vox_end);
+        cursor = last;
+        if (first == last) {
+            return;
+        }
+        uint start = uint(first - idxBegin);
+        uint count = uint(last - first);
+        if (!ranges.empty() && (ranges.back().first + ranges.back().count == start)) {
+            ranges.back().count += count;
+        } else {
+            ranges.push_back({ start, count });
+        }
+    };
+
+    uint64_t run_begin = 0, run_end = 0;
+    uint64_t layer_first = cull.begin / cull.layer_size;
+    uint64_t layer_last = (cull.end + cull.layer_size - 1) / cull.layer_size;
+    uint theta_size = cull.phi_size << 1;
+
+    for (uint64_t layer = layer_first; layer < layer_last; layer++) {
+        for (uint theta = 0; theta < theta_size; theta++) {
+            uint row_pos = theta * cull.phi_size;
+            bool front = (theta <= cull.phi_size);
+            uint lo = (front) ? cull.phi_front : 0;
+            uint hi = (front) ? cull.phi_size : cull.phi_back;
+            if (cull.theta_all > row_pos) {
+                lo = std::max(lo, cull.theta_all - row_pos);
+            }
+
+            uint64_t row = layer * cull.layer_size + row_pos;
+            uint64_t vox_begin = std::max(row + lo, cull.begin);
+            uint64_t vox_end = std::min(row + hi, cull.end);
+            if (vox_begin >= vox_end) {
+                continue;
+            }
+
+            if (vox_begin == run_end) {
+                run_end = vox_end;
+            } else {
+                if (run_end > run_begin) {
+                    addRun(run_begin, run_end);
+                }
+                run_begin = vox_begin;
+                run_end = vox_end;
+            }
+        }
+    }
+    if (run_end > run_begin) {
+        addRun(run_begin, run_end);
+    }
+}
+
 void CloudManager::update([[maybe_unused]] double time) {
     Manager::update(time);
 }
@@ -644,26 +1970,34 @@ void CloudManager::cloudTest(int n_max) {
  *       the quantum numbers and the probability densities.
  */
 void CloudManager::cloudTestCSV() {
+    int steps_local = this->cloudResolution;
+    double deg_fac_local = this->deg_fac;
+    dvec radii(200, 0.0);
+    dvec cosPhis(steps_local, 0.0);
+    dvec Rs(200, 0.0);
+    dvec legs(steps_local, 0.0);
+    std::iota(radii.begin(), radii.end(), 1.0);
+    for (int j = 0; j < steps_local; j++) {
+        cosPhis[j] = cos(j * deg_fac_local);
+    }
+
     for (int n = 1; n <= 8; n++) {
         for (int l = 0; l <= n-1; l++) {
+            wavefuncRadialBatch(n, l, radii, &Rs[0]);
             for (int m_l = 0; m_l <= l; m_l++) {
                 std::cout << n << l << m_l;
+                double orbNorm = atomix::orbitals::norm_angular(l, m_l);
+                wavefuncAngLegBatch(l, m_l, cosPhis, &legs[0]);
 
                 for (int k = 1; k <= 200; k++) {
                     double max_pdv = 0;
-                    int steps_local = this->cloudResolution;
-                    double deg_fac_local = this->deg_fac;
-                    double orbNorm = this->norm_constY[DSQ(l, m_l)];
-                    double R = wavefuncRadial(n, l, k);
+                    double R = Rs[k - 1];
 
                     for (int i = 0; i < steps_local; i++) {
                         double theta = i * deg_fac_local;
                         std::complex<double> orbExp = wavefuncAngExp(m_l, theta);
                         for (int j = 0; j < steps_local; j++) {
-                            double phi = j * deg_fac_local;
-
-                            double orbLeg = wavefuncAngLeg(l, m_l, phi);
-                            std::complex<double> Y = orbExp * orbNorm * orbLeg;
+                            std::complex<double> Y = orbExp * orbNorm * legs[j];
                             double pdv = wavefuncPDV(R * Y, k, l);
 
                             if (pdv > max_pdv) {
@@ -707,7 +2041,7 @@ void CloudManager::radialMaxCSV(fvec &vecPDV, [[maybe_unused]] int n_max) {
         const auto max_it = std::max_element(it, it + chunkSize);
         uint i = std::distance(vecPDV.cbegin(), max_it);
         maxPDVs.push_back(*max_it);
-        radii.push_back(this->allVertices[i].x);
+        radii.push_back(static_cast<float>((i / chunkSize) + 1) / this->cloudLayerDivisor);
         it += chunkSize;
     }
 
@@ -733,31 +2067,6 @@ void CloudManager::radialMaxCSV(fvec &vecPDV, [[maybe_unused]] int n_max) {
     std::cout << std::endl;
 }
 
-/**
- * @brief Compute the factorial of a given integer `n`.
- *
- * This function takes an integer `n` as input and returns its factorial.
- * The function uses a simple iterative approach to compute the factorial.
- *
- * @param[in] n The integer to compute the factorial of.
- * @returns The factorial of `n`, which is the product of all positive integers less than or equal to `n`.
- */
-int64_t CloudManager::fact(int n) {
-    int64_t prod = n ? n : 1;
-    // int orig = n;
-
-    while (n > 2) {
-        prod *= --n;
-    }
-
-    /* if (orig && prod > std::numeric_limits<int>::max()) {
-        std::cout << orig << "! was too large for [int] type." << std::endl;
-        orig = 0;
-    } */
-
-    return prod;
-}
-
 /**
  * @brief Compute the radial wavefunction for the given quantum numbers.
  *
@@ -779,7 +2088,44 @@ double CloudManager::wavefuncRadial(int n, int l, double r) {
     double expFunc = exp(-rho/2.0);
     double rhol = pow(rho, l);
 
-    return laguerre * rhol * expFunc * this->norm_constR[DSQ(n, l)];
+    return laguerre * rhol * expFunc * atomix::orbitals::norm_radial(n, l);
+}
+
+/**
+ * @brief Compute the radial wavefunction for the given quantum numbers at many radii.
+ *
+ * Batch form of wavefuncRadial(). States with n <= MAX_SHELLS use the compiled closed-form
+ * kernel for (n,l), which is selected once and then inlined across all radii. Anything larger
+ * falls back to the SIMD Laguerre batch before applying the rho^l, exponential, and
+ * normalization factors.
+ *
+ * @param[in] n The principal quantum number.
+ * @param[in] l The orbital angular momentum.
+ * @param[in] radii The radii at which to evaluate the wavefunction.
+ * @param[out] out Destination for `radii.size()` results.
+ */
+void CloudManager::wavefuncRadialBatch(int n, int l, const dvec &radii, double *out) {
+    size_t count = radii.size();
+    if (atomix::orbitals::radial_batch(n, l, &radii[0], out, count)) {
+        return;
+    }
+
+    double norm = atomix::orbitals::normR(n, l);
+    dvec rhos(count, 0.0);
+    for (size_t i = 0; i < count; i++) {
+        rhos[i] = 2.0 * radii[i] / static_cast<double>(n);
+    }
+
+    lagpv((n - l - 1), ((l << 1) + 1), &rhos[0], out, count);
+
+    for (size_t i = 0; i < count; i++) {
+        double rho = rhos[i];
+        double rhol = 1.0;
+        for (int l_times = l; l_times > 0; l_times--) {
+            rhol *= rho;
+        }
+        out[i] *= rhol * exp(-rho * 0.5) * norm;
+    }
 }
 
 /**
@@ -805,7 +2151,7 @@ std::complex<double> CloudManager::wavefuncAngular(int l, int m_l, double theta,
     ibase *= m_l * theta;
     std::complex<double> expFunc = exp(ibase);
 
-    return expFunc * legendre * this->norm_constY[DSQ(l, m_l)];
+    return expFunc * legendre * atomix::orbitals::norm_angular(l, m_l);
 }
 
 /**
@@ -842,6 +2188,24 @@ double CloudManager::wavefuncAngLeg(int l, int m_l, double phi) {
     return legp(l, abs(m_l), cos(phi));
 }
 
+/**
+ * @brief Compute the associated Legendre polynomial term of the angular wavefunction at many angles.
+ *
+ * Batch form of wavefuncAngLeg(), taking pre-computed cos(phi) values. Uses the compiled
+ * closed-form kernel for (l,|m_l|) when l < MAX_SHELLS, else the SIMD Legendre batch.
+ *
+ * @param[in] l The orbital angular momentum.
+ * @param[in] m_l The z-component of the orbital angular momentum.
+ * @param[in] cosPhis The cosines of the azimuthal angles at which to evaluate.
+ * @param[out] out Destination for `cosPhis.size()` results.
+ */
+void CloudManager::wavefuncAngLegBatch(int l, int m_l, const dvec &cosPhis, double *out) {
+    if (atomix::orbitals::legendre_batch(l, m_l, &cosPhis[0], out, cosPhis.size())) {
+        return;
+    }
+    legpv(l, abs(m_l), &cosPhis[0], out, cosPhis.size());
+}
+
 /**
  * @brief Compute the probability density value of the orbital wavefunction.
  *
@@ -926,41 +2290,6 @@ double CloudManager::wavefuncPsi2(int n, int l, int m_l, double r, double theta,
     return (std::conj(Psi) * Psi).real() * factor;
 }
 
-/**
- * @brief Compute the normalizing constants for the orbital wavefunctions.
- *
- * This function takes the maximum principal quantum number `max_n` and
- * computes the normalizing constants for all orbital wavefunctions with
- * n <= max_n. The constants are stored in the `norm_constR` and `norm_constY`
- * maps of the CloudManager object.
- *
- * @param[in] max_n The maximum principal quantum number.
- */
-void CloudManager::wavefuncNorms(int n_max) {
-    int max_l = n_max - 1;
-
-    for (int n = n_max; n > 0; n--) {
-        double rho_r = (2.0 * this->atomZ) / n;
-        for (int l = n-1; l >= 0; l--) {
-            int nl1 = n - l - 1;
-            int key = DSQ(n, l);
-
-            double value = pow(rho_r, (3.0/2.0)) * sqrt(fact(nl1) / (2.0 * n * fact(n+l)));
-            this->norm_constR[key] = value;
-        }
-    }
-    for (int l = max_l; l >= 0; l--) {
-        int l21 = 2 * l + 1;
-        for (int m_l = -l; m_l <= l; m_l++) {
-            int magM = abs(m_l);
-            int key = DSQ(l, m_l);
-
-            double value = sqrt((l21 / (4.0 * M_PI)) * (fact(l - magM) / static_cast<double>(fact(l + magM))));
-            this->norm_constY[key] = value;
-        }
-    }
-}
-
 /**
  * @brief Reset the cloud rendering process for the next frame.
  *
@@ -968,8 +2297,7 @@ void CloudManager::wavefuncNorms(int n_max) {
  * atomic number.
  */
 void CloudManager::clearForNext() {
-    dataStaging.assign(this->pixelCount, 0.0);
-    allData.assign(this->pixelCount, 0.0f);
+    // allData keeps its size, as the next bake overwrites every voxel
     cloudOrbitals.clear();
     this->orbitalIdx = 0;
     this->allPDVMaximum = 0;
@@ -997,8 +2325,13 @@ void CloudManager::resetManager() {
     this->dataStaging.clear();
     this->idxCulledTolerance.clear();
     this->idxCulledSlider.clear();
-    this->norm_constR.clear();
-    this->norm_constY.clear();
+    this->packedData.clear();
+    this->pdvOrder.clear();
+    this->pdvOrderValid = false;
+    this->idxIsPdvPrefix = false;
+    this->iboHoldsPdvOrder = false;
+    this->bakeCulled = false;
+    this->flushFieldCache();
 
     this->pixelCount = 0;
     this->colourCount = 0;
@@ -1011,6 +2344,104 @@ void CloudManager::resetManager() {
  *  Generators
  */
 
+/**
+ * @brief Flag the PDV buffer for upload, quantizing it first if a packed format is set.
+ *
+ * @details
+ * allData holds PDVs normalized to [0, 1], so GPU renders can upload it as 16-bit half or
+ * unorm values, or 8-bit unorm values, which the vertex fetch expands back to float. CPU
+ * renders upload colours instead, so allData is left as-is and nothing is packed. With
+ * gathered streams, the PDVs are uploaded per visible voxel by genIndexBuffer() instead.
+ */
+void CloudManager::genDataBuffer() {
+    Manager::genDataBuffer();
+
+    if (!this->cfg.cpu && this->gatherStreams) {
+        this->mStatus.clear(em::UPD_DATA);
+        return;
+    }
+    if (this->cfg.cpu || (this->dataFormat == CloudDataFormat::FLOAT32)) {
+        this->packedData.clear();
+        return;
+    }
+
+    this->packData(false);
+    this->dataSize = this->packedData.size();
+}
+
+/**
+ * @brief Flag the IBO for upload, first gathering the visible PDVs if drawing without indices.
+ *
+ * @details
+ * With gathered streams (setGatherStreams()), GPU renders draw the visible points directly
+ * from two dense vertex streams in allIndices order: the voxel ids themselves, and their
+ * PDVs in the current data format. The full-grid PDV buffer is never uploaded, so VRAM
+ * follows the visible point count. Slider draw ranges still apply, as positions in allIndices.
+ */
+void CloudManager::genIndexBuffer() {
+    Manager::genIndexBuffer();
+
+    if (this->cfg.cpu || !this->gatherStreams) {
+        return;
+    }
+
+    this->packData(true);
+    this->dataCount = allIndices.size();
+    this->dataSize = this->packedData.size();
+    this->mStatus.set(em::UPD_DATA);
+}
+
+/**
+ * @brief Pack PDVs from allData into packedData in the current data format.
+ *
+ * @param gather Pack only the voxels in allIndices, in order, instead of all of allData.
+ */
+void CloudManager::packData(bool gather) {
+    size_t width = (this->dataFormat == CloudDataFormat::FLOAT32) ? sizeof(float)
+                 : (this->dataFormat == CloudDataFormat::UNORM8) ? sizeof(uint8_t) : sizeof(uint16_t);
+    uint8_t *dst = nullptr;
+    CloudDataFormat format = this->dataFormat;
+
+    auto store = [&dst, format](size_t i, float pdv) {
+        switch (format) {
+            case CloudDataFormat::FLOAT32:
+                reinterpret_cast<float *>(dst)[i] = pdv;
+                break;
+            case CloudDataFormat::FLOAT16:
+                reinterpret_cast<uint16_t *>(dst)[i] = glm::packHalf1x16(pdv);
+                break;
+            case CloudDataFormat::UNORM16:
+                reinterpret_cast<uint16_t *>(dst)[i] = glm::packUnorm1x16(pdv);
+                break;
+            default:
+                dst[i] = glm::packUnorm1x8(pdv);
+                break;
+        }
+    };
+
+    reclaimBuffer(this->packedData, this->packedLoan, this->snapPublished.dataData);
+    if (gather) {
+        this->sizeBuffer(this->packedData, allIndices.size() * width);
+        dst = this->packedData.data();
+        const uint *first = allIndices.data();
+        const float *dataStart = allData.data();
+        std::for_each(std::execution::par_unseq, allIndices.cbegin(), allIndices.cend(),
+            [first, dataStart, &store](const uint &voxel) {
+                store(&voxel - first, dataStart[voxel]);
+            });
+    } else {
+        this->sizeBuffer(this->packedData, allData.size() * width);
+        dst = this->packedData.data();
+        const float *dataStart = allData.data();
+        int layer_size = this->cloudResolution * (this->cloudResolution >> 1);
+        this->forEachLayer([dataStart, layer_size, &store](int layer) {
+            size_t base = size_t(layer) * layer_size;
+            for (size_t i = base; i < base + layer_size; i++) {
+                store(i, dataStart[i]);
+            }
+        });
+    }
+}
 
 /*
  *  Getters -- Size
@@ -1060,6 +2491,7 @@ int CloudManager::getMaxLayer(double tolerance, int n_max, int divisor) {
  */
 int CloudManager::getMaxRadius(double tolerance, int n_max) {
     int divSciExp = std::abs(floor(log10(tolerance)));
+    divSciExp = std::clamp(divSciExp, 1, 4);        // Rows cover 1e-1 to 1e-4; float 1e-4 rounds just below it
     int maxRadius = cm_maxRadius[divSciExp - 1][n_max - 1];
     return maxRadius;
 }
@@ -1072,6 +2504,16 @@ int CloudManager::getMaxRadius(double tolerance, int n_max) {
  *  Getters -- Data
  */
 
+/**
+ * @brief Get the PDV data for the cloudData VBO, in the format set by setDataFormat().
+ *
+ * @return A pointer to the packed PDVs if quantized, otherwise to allData.
+ */
+const void* CloudManager::getDataData() {
+    assert(mStatus.hasAll(em::DATA_READY));
+    return this->packedData.empty() ? Manager::getDataData() : this->packedData.data();
+}
+
 /**
  * @brief Checks if the vertices have been generated.
  *
@@ -1289,12 +2731,14 @@ void CloudManager::testThreadingInit([[maybe_unused]] AtomixCloudConfig *config,
     AtomixCloudConfig *oldCfg = tests[3].first;
     harmap *oldMap = tests[3].second;
 
-    uint pool_min = 16;
+    // Bake threads, as sized by setBakeThreads()
+    uint pool_min = 1;
     uint pool_max = std::thread::hardware_concurrency();
     uint pstep = 1;
 
-    uint vecs_min = 0;
-    uint vecs_max = 0;
+    // Layer grain, as set by setLayerGrain()
+    uint vecs_min = 1;
+    uint vecs_max = 1;
     uint vstep = 1;
 
     uint loop_min = 1;
@@ -1303,6 +2747,9 @@ void CloudManager::testThreadingInit([[maybe_unused]] AtomixCloudConfig *config,
 
     uint test_max = 4;
 
+    int threadsUsed = bakeThreads;
+    int grainUsed = layerGrain;
+
     uint vruns = ((vecs_max - vecs_min) / vstep) + 1;
     uint pruns = ((pool_max - pool_min) / pstep) + 1;
     uint lruns = ((loop_max - loop_min) / lstep) + 1;
@@ -1333,31 +2780,33 @@ void CloudManager::testThreadingInit([[maybe_unused]] AtomixCloudConfig *config,
         oldCfg = con;
         oldMap = map;
         for (uint v = vecs_min; v <= vecs_max; v += vstep) {
-            // this->cm_vecs = v;
+            setLayerGrain(v);
             for (uint p = pool_min; p <= pool_max; p += pstep) {
-                // sleep(sleep_time);
+                setBakeThreads(p);
                 for (uint l = loop_min; l <= loop_max; l += lstep) {
                     // this->cm_loop = l;
                     for (uint i = 0; i < truns; i++) {
-                        if (cfgChanged) {
-                            resetManager();
-                            newConfig(con);
-                            receiveCloudMap(map);
-                            createThreaded();
-                            cfgChanged = mapChanged = false;
-                        } else if (mapChanged) {
-                            clearForNext();
-                            receiveCloudMap(map);
-                            mapChanged = false;
-                        }
-                        mStatus.set(em::INIT | UPD_MATRICES);
-                        mStatus.clear(em::DATA_READY);
-                        double t = bakeOrbitalsThreaded();
-                        mStatus.clear(em::INDEX_GEN);
-                        cullToleranceThreaded();
-                        mStatus.clear(em::INDEX_READY);
-                        cullSliderThreaded();
-                        times[i] = t;
+                        bakeArenas().bake->execute([&] {
+                            if (cfgChanged) {
+                                resetManager();
+                                newConfig(con);
+                                receiveCloudMap(map);
+                                createThreaded();
+                                cfgChanged = mapChanged = false;
+                            } else if (mapChanged) {
+                                clearForNext();
+                                receiveCloudMap(map);
+                                mapChanged = false;
+                            }
+                            mStatus.set(em::INIT | UPD_MATRICES);
+                            mStatus.clear(em::DATA_READY);
+                            double t = bakeOrbitalsThreaded();
+                            mStatus.clear(em::INDEX_GEN);
+                            cullToleranceThreaded();
+                            mStatus.clear(em::INDEX_READY);
+                            cullSliderThreaded();
+                            times[i] = t;
+                        });
                     }
                     double avg_t = std::accumulate(times.cbegin(), times.cend(), 0.0) / truns;
                     test_times.push_back(avg_t);
@@ -1388,5 +2837,7 @@ void CloudManager::testThreadingInit([[maybe_unused]] AtomixCloudConfig *config,
     }
     std::cout << std::endl;
 
+    setLayerGrain(grainUsed);
+    setBakeThreads(threadsUsed);
     mStatus.set(em::UPD_VBO);
 }
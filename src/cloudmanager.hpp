@@ -28,18 +28,27 @@
 #include <format>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <complex>
 #include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <thread>
 
 #include "manager.hpp"
+#include "cloudcache.hpp"
+#include "cloudestimator.hpp"
 
 // Mac's Clang does not support Special Math functions from STL. Must use Boost, which is 4x slower 
 // Got around this by yanking the STD math functions out and calling them directly.
 #include "special.hpp"
+#include "orbitals.hpp"
 const inline auto& legp = static_cast<double(*)(uint, uint, double)>(atomix::special::atomix_legendre);
 const inline auto& lagp = static_cast<double(*)(uint, uint, double)>(atomix::special::atomix_laguerre);
+const inline auto& legpv = static_cast<void(*)(uint, uint, const double *, double *, size_t)>(atomix::special::atomix_legendre_batch);
+const inline auto& lagpv = static_cast<void(*)(uint, uint, const double *, double *, size_t)>(atomix::special::atomix_laguerre_batch);
 
 // BS::thread_pool Priority slows the program down for optional benefit of low/high prio 
 // #define BS_THREAD_POOL_ENABLE_PRIORITY
@@ -55,6 +64,68 @@ const uint cm_maxRadius[4][8] = { {  6, 13, 24, 39, 58,  80, 107, 138 },    // T
                                   {  9, 20, 35, 55, 78, 106, 139, 175 },    // Tolerance = 0.001
                                   { 11, 23, 40, 61, 87, 117, 152, 191 } };  // Tolerance = 0.0001
 
+/* Selects the compute strategy used by bakeOrbitalsThreaded() */
+enum class BakeMode {
+    PER_VOXEL,      // Evaluate every recipe in full at every voxel (reference)
+    TABLES,         // Build separable radial/angular tables, then combine per voxel
+    RING_TABLES     // As TABLES, but with one all-degree Legendre sweep per phi ring
+};
+
+/* Stage of the request CloudManager is working on, for progress reports */
+enum class BakeStage : uint {
+    IDLE,
+    CREATE,         // Sizing the grid, and building vertices for CPU rendering
+    BAKE,           // Computing the PDV of every voxel; work units are voxels
+    CULL,           // Compacting the tolerance-culled indices; work units are voxels scanned
+    SLIDER          // Applying the culling sliders
+};
+
+/* Progress of the current stage and of the whole job, read by the GUI thread while a request runs */
+struct BakeProgress {
+    BakeStage stage = BakeStage::IDLE;
+    uint64_t done = 0;
+    uint64_t total = 0;
+    uint64_t jobDone = 0;       // Work units of every stage and pass of the job, so far
+    uint64_t jobTotal = 0;
+};
+
+/* Flattened orbital recipes with normalized weights, prepared once per bake */
+struct BakeRecipes {
+    std::vector<int> ns;
+    std::vector<int> ls;
+    std::vector<int> ms;
+    dvec ws;
+    dvec ny;
+    dvec nr;
+    int count = 0;
+    int total_l = 0;
+    bool azimuthal = false;     // All recipes share one m, so |Psi|^2 is independent of theta
+    bool equatorial = false;    // All recipes share the parity of l+|m|, so |Psi|^2 mirrors about z = 0
+};
+
+/* Per-orbital psi factors kept across recipe edits, since psi_nlm = R_nl(layer) * Y_lm(theta, phi) */
+struct FieldCache {
+    std::unordered_map<int, dvec> radial;                                   // R_nl[layer], keyed by DSQ(n, l)
+    std::unordered_map<int, std::vector<std::complex<double>>> angular;     // N_Y * Y_lm[theta * phi], keyed by DSQ(l, m)
+    std::unordered_map<int, uint64_t> radialUse;
+    std::unordered_map<int, uint64_t> angularUse;
+    ivec3 grid = ivec3(0);                                                  // (resolution, divisor, layers) the fields were baked for
+    uint64_t stamp = 0;
+    size_t bytes = 0;
+};
+
+
+/* Slider culls as half-open bounds in voxel space: layer position, phi runs, and voxel range */
+struct SliderCull {
+    uint layer_size = 0;
+    uint phi_size = 0;
+    uint theta_all = 0;         // Cull layer positions below this
+    uint phi_front = 0;         // Cull phi below this in the front half (theta <= phi_size)
+    uint phi_back = 0;          // Cull phi at or above this in the back half
+    uint64_t begin = 0;
+    uint64_t end = 0;
+};
+
 
 class CloudManager : public Manager {
 public:
@@ -65,10 +136,39 @@ public:
     void update(double time) override final;
     
     size_t getColourSize();
-    int getMaxLayer(double tolerance, int n_max, int divisor);
-    int getMaxRadius(double tolerance, int n_max);
+    static int getMaxLayer(double tolerance, int n_max, int divisor);
+    static int getMaxRadius(double tolerance, int n_max);
     bool hasVertices();
     bool hasBuffers();
+    int getGridResolution() { return this->cloudResolution; }
+    int getGridDivisor() { return this->cloudLayerDivisor; }
+
+    void setBakeMode(BakeMode mode) { this->bakeMode = mode; }
+    BakeMode getBakeMode() { return this->bakeMode; }
+    void setFieldCacheBudget(size_t bytes) { this->fieldCacheBudget = bytes; }
+    size_t getFieldCacheBytes() { return this->fieldCache.bytes; }
+    void setToleranceIndex(bool enable) { this->toleranceIndex = enable; }
+    void setProgressive(bool enable) { this->progressive = enable; }
+    void setDataFormat(CloudDataFormat format) { this->dataFormat = format; }
+    CloudDataFormat getDataFormat() { return this->dataFormat; }
+    void setGatherStreams(bool enable) { this->gatherStreams = enable; }
+    const void* getDataData() override final;
+    bool hasRefinement() { return !this->refineSteps.empty(); }
+    bool canCull() { return this->mStatus.hasAll(em::INDEX_GEN); }
+    static std::shared_ptr<const ManagerSnapshot> cullSnapshot(const ManagerSnapshot &snap, const AtomixCloudConfig &config);
+    void refineCloud();
+    void cancel() { this->requestSerial++; }
+    static void setBakeThreads(int threads);
+    static int getBakeThreads();
+    static void setLayerGrain(int layers) { layerGrain = std::max(1, layers); }
+    BakeProgress getProgress();
+    void setCacheDir(const std::string &dir, uint64_t maxBytes = CloudCache::DEFAULT_CAP) { this->diskCache.setDirectory(dir, maxBytes); }
+    void setEstimator(CloudEstimator *model) { this->estimator = model; }
+    bool exportCloud(const std::string &path);
+    uint64_t getVoxelCount() { return this->pixelCount; }
+    uint64_t getVisibleCount() { return this->idxCulledTolerance.size(); }
+    const std::array<double, 6>& getStageTimes() { return this->cm_times; }
+    const std::array<std::string, 6>& getStageLabels() { return this->cm_labels; }
 
     void printRecipes();
     void printMaxRDP_CSV(const int &n, const int &l, const int &m_l, const double &maxRDP);
@@ -79,10 +179,37 @@ protected:
 private:
     void initManager() override;
     void receiveCloudMap(harmap *inMap);
+    void processRequest(AtomixCloudConfig *config, harmap *inMap, bool generator, uint64_t request);
+    void processRefinement(uint64_t request);
 
     double createThreaded();
     double bakeOrbitalsThreaded();
+    void bakeRecipes(BakeRecipes &recipes);
+    void bakePerVoxel(const BakeRecipes &recipes);
+    void bakeTables(const BakeRecipes &recipes);
+    void bakeFields(const BakeRecipes &recipes);
+    void trimFieldCache();
+    void flushFieldCache();
     double cullToleranceThreaded();
+    void compactAbove(float threshold, uvec &out);
+    void cullToleranceIndexed();
+    static SliderCull sliderBounds(const AtomixCloudConfig &config, int resolution, uint layers);
+    static void genSliderRanges(const SliderCull &cull, const uint *idxBegin, const uint *idxEnd, std::vector<DrawRange> &ranges);
+    bool loadCachedCloud();
+    void storeCachedCloud();
+    bool planProgressive();
+    int passResolution(int step);
+    uint64_t passVoxels(int step);
+    void refineCloudPass();
+    void fillSnapshot(ManagerSnapshot &snap, uint flags, bool lend) override final;
+    std::shared_ptr<const void> lendData() override final;
+    bool cancelled() { return this->requestSerial.load(std::memory_order_relaxed) != this->activeRequest; }
+    void abandonRequest();
+    void recordBake(bool created);
+    void beginStage(BakeStage stage, uint64_t total);
+    void beginJob(uint64_t total);
+    template <typename F> void forEachLayer(F &&fn);
+    void advance(uint64_t units) { this->progressDone.fetch_add(units, std::memory_order_relaxed); this->jobDone.fetch_add(units, std::memory_order_relaxed); }
     double expandPDVsToColours();
     double cullSliderThreaded();
 
@@ -90,15 +217,15 @@ private:
     void resetManager() override;
     
     double wavefuncRadial(int n, int l, double r);
+    void wavefuncRadialBatch(int n, int l, const dvec &radii, double *out);
     std::complex<double> wavefuncAngular(int l, int m_l, double theta, double phi);
     std::complex<double> wavefuncAngExp(int m_l, double theta);
     double wavefuncAngLeg(int l, int m_l, double phi);
+    void wavefuncAngLegBatch(int l, int m_l, const dvec &cosPhis, double *out);
     std::complex<double> wavefuncPsi(double radial, std::complex<double> angular);
     double wavefuncRDP(double R, double r, int l);
     double wavefuncPDV(std::complex<double> Psi, double r, int l);
     double wavefuncPsi2(int n, int l, int m_l, double r, double theta, double phi);
-    void wavefuncNorms(int n);
-    int64_t fact(int n);
 
     size_t setColourCount();
     size_t setColourSize();
@@ -114,19 +241,34 @@ private:
     void testThreadingInit(AtomixCloudConfig *config, harmap *inMap);
 
     void genVertexArray() override final {Manager::genVertexArray();}
-    void genDataBuffer() override final {Manager::genDataBuffer();}
+    void genDataBuffer() override final;
     void genColourBuffer() override final {Manager::genColourBuffer();}
-    void genIndexBuffer() override final {Manager::genIndexBuffer();}
+    void genIndexBuffer() override final;
+    void packData(bool gather);
 
     AtomixCloudConfig cfg;
 
     dvec pdvStaging;
     uvec idxCulledTolerance;
+    dvec layerMax;                      // Per-layer PDV maxima from the bake
+    uvec layerCounts;                   // Per-layer counts of PDVs above countedTolerance
+    float countedTolerance = -1.0f;
+    bool toleranceIndex = false;
+    uvec pdvOrder;                      // Indices of voxels above indexFloor, by descending PDV
+    float indexFloor = 0.0f;
+    bool pdvOrderValid = false;
+    bool idxIsPdvPrefix = false;        // idxCulledTolerance is currently a prefix of pdvOrder
+    bool bakeCulled = false;            // The current bake has been tolerance-culled at least once
+    bool iboHoldsTolerance = false;     // allIndices is idxCulledTolerance as last handed to the IBO
+    bool iboHoldsPdvOrder = false;      // allIndices is all of pdvOrder as last handed to the IBO, drawn as a prefix
+    const float TOLERANCE_INDEX_FLOOR = 0.0001f;
     uvec idxCulledSlider; // Not needed with threading
+    CloudDataFormat dataFormat = CloudDataFormat::FLOAT32;
+    std::vector<uint8_t, BufferAllocator<uint8_t>> packedData;    // allData quantized to dataFormat for the GPU cloudData VBO
+    std::weak_ptr<std::vector<uint8_t, BufferAllocator<uint8_t>>> packedLoan;
+    bool gatherStreams = false;         // packedData holds only the voxels in allIndices, drawn without indices
     double allPDVMaximum;
     
-    std::unordered_map<int, double> norm_constR;
-    std::unordered_map<int, double> norm_constY;
     harmap cloudOrbitals;
 
     uint colourCount = 0;
@@ -139,13 +281,32 @@ private:
     int max_n = 0;
     int opt_max_radius = 0;
     float cm_culled = 0;
-    const int MAX_SHELLS = 8;
+    const int MAX_SHELLS = atomix::orbitals::MAX_N;
 
     size_t cm_pixels;
     std::mutex cm_proc_coarse;
     std::mutex cm_proc_fine;
-    std::array<double, 4> cm_times = { 0.0, 0.0, 0.0, 0.0 };
-    std::array<std::string, 4> cm_labels = { "Create():        ", "BakeOrbitals():  ", "CullTolerance(): ", "CullSlider():    " };
+    std::array<double, 6> cm_times = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    std::array<std::string, 6> cm_labels = { "Create():        ", "BakeOrbitals():  ", " -- Tables:      ", " -- Combine:     ", "CullTolerance(): ", "CullSlider():    " };
+    BakeMode bakeMode = BakeMode::RING_TABLES;
+    FieldCache fieldCache;
+    size_t fieldCacheBudget = 256 * 1024 * 1024;
+    size_t bakeFieldBytes = 0;          // Bytes of the cached fields read by the last bake, for the estimator
+    CloudCache diskCache;
+    CloudEstimator *estimator = nullptr;    // Calibrated from each finished bake, if set
+    bool progressive = true;
+    std::vector<int> refineSteps;       // Pending decimation steps of a progressive bake, coarsest first
+    const uint64_t PROGRESSIVE_PIXELS = 1 << 21;
+    std::atomic<uint64_t> requestSerial = 0;    // Bumped by each generating request and cancel()
+    uint64_t activeRequest = 0;                 // requestSerial as seen by the request holding cm_proc_coarse
+    const uint64_t CANCEL_CHUNK = 1 << 18;      // Voxels per PER_VOXEL slab between cancellation checks
+    std::atomic<BakeStage> progressStage = BakeStage::IDLE;
+    std::atomic<uint64_t> progressDone = 0;     // Work units of progressStage completed so far
+    std::atomic<uint64_t> progressTotal = 0;
+    std::atomic<uint64_t> jobDone = 0;          // Work units completed since beginJob(), across stages and passes
+    std::atomic<uint64_t> jobTotal = 0;
+    static inline int bakeThreads = 0;          // 0 for all cores but one, which is left to the GUI and render threads
+    static inline int layerGrain = 1;           // Minimum layers per block in forEachLayer()
 
     int cloudResolution = 0;
     int cloudLayerDivisor = 0;
@@ -26,14 +26,20 @@
 #define CONFIGPARSER_H
 
 #include <filesystem>
+#include <variant>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QMetaType>
+#include <QStringList>
 
 #include "global.hpp"
 
 
+Q_DECLARE_METATYPE(AtomixWaveConfig);
+Q_DECLARE_METATYPE(AtomixCloudConfig);
+
 using SuperConfig = std::variant<AtomixWaveConfig, AtomixCloudConfig>;
 
 
@@ -52,6 +58,7 @@ struct AtomixFiles {
         resourcesDir = rootDir + "res/";
         fontsDir = resourcesDir + "fonts/";
         iconsDir = resourcesDir + "icons/";
+        cacheDir = rootDir + "cache/";
 
         return true;
     }
@@ -62,6 +69,7 @@ struct AtomixFiles {
     constexpr std::string& resources() { return resourcesDir; }
     constexpr std::string& fonts() { return fontsDir; }
     constexpr std::string& icons() { return iconsDir; }
+    constexpr std::string& cache() { return cacheDir; }
 
     const std::string WAVEXT = ".wave";
     const std::string CLDEXT = ".cloud";
@@ -75,9 +83,30 @@ private:
     std::string resourcesDir;
     std::string fontsDir;
     std::string iconsDir;
+    std::string cacheDir;
 };
 Q_DECLARE_METATYPE(AtomixFiles);
 
+namespace atomix {
+    /**
+     * @brief Convert a QStringList to a std::vector<std::string>.
+     *
+     * @param[in] list The QStringList to convert.
+     *
+     * @return A std::vector<std::string> containing the same elements as the
+     * QStringList.
+     */
+    inline std::vector<std::string> stringlistToVector(QStringList list) {
+        std::vector<std::string> vec;
+        vec.reserve(list.size());
+
+        for (auto str : list) {
+            vec.push_back(str.toStdString());
+        }
+        return vec;
+    }
+}
+
 
 class FileHandler {
     public:
@@ -29,8 +29,9 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
-#include <QMetaType>
-#include <QStringList>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -42,6 +43,8 @@
 
 
 using harmap = std::map<int, std::vector<glm::ivec3>>;
+using uint = unsigned int;
+using ushort = unsigned short;
 
 #define SWIDTH 1280
 #define SHEIGHT 720
@@ -69,7 +72,6 @@ struct AtomixWaveConfig {
     bool sphere = false;                            // Spherical waves on/off [bool]
     std::string type = "wave";                      // Wave type [string]
 };
-Q_DECLARE_METATYPE(AtomixWaveConfig);
 
 struct AtomixCloudConfig {
     // Orbital cloud config values
@@ -83,7 +85,20 @@ struct AtomixCloudConfig {
     bool cpu = false;                               // GPU rendering on/off [bool]
     std::string type = "cloud";                      // Cloud type [string]
 };
-Q_DECLARE_METATYPE(AtomixCloudConfig);
+
+/* Storage format of the cloud PDV stream ("cloudData" VBO); all read as float by the shader */
+enum class CloudDataFormat : uint32_t {
+    FLOAT32 = 0,
+    FLOAT16 = 1,
+    UNORM16 = 2,
+    UNORM8 = 3
+};
+
+/* A contiguous run of the index buffer to draw, in indices */
+struct DrawRange {
+    uint first = 0;
+    uint count = 0;
+};
 
 /** 
  * BitFlag
@@ -261,24 +276,6 @@ namespace atomix {
         }
         std::cout << std::endl;
     }
-
-    /**
-     * @brief Convert a QStringList to a std::vector<std::string>.
-     *
-     * @param[in] list The QStringList to convert.
-     *
-     * @return A std::vector<std::string> containing the same elements as the
-     * QStringList.
-     */
-    inline std::vector<std::string> stringlistToVector(QStringList list) {
-        std::vector<std::string> vec;
-        vec.reserve(list.size());
-
-        for (auto str : list) {
-            vec.push_back(str.toStdString());
-        }
-        return vec;
-    }
 }
 
 /* Math constants */
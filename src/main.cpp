@@ -55,6 +55,14 @@ int main(int argc, char* argv[]) {
     QCommandLineOption cliProfiling({ "p", "profiling" }, QApplication::translate("main", "enable profiling"));
     QCommandLineOption cliTesting({ "t", "testing" }, QApplication::translate("main", "enable testing"));
     QCommandLineOption cliResetGeometry({ "r", "reset-geometry" }, QApplication::translate("main", "reset window geometry (instead of loading saved geometry)"));
+    QCommandLineOption cliGather("gather", QApplication::translate("main", "draw clouds from streams gathered to visible points, instead of indexing the full grid"));
+    QCommandLineOption cliToleranceIndex("tolerance-index", QApplication::translate("main", "keep cloud voxels sorted by PDV, so tolerance changes re-cull by a prefix search instead of a full scan"));
+    QCommandLineOption cliHugePages("huge-pages", QApplication::translate("main", "advise cloud buffers as transparent huge pages (Linux only)"));
+    QCommandLineOption cliRamBudget("ram-budget", QApplication::translate("main", "host memory budget for clouds, in MiB; picks the largest resolution and layer divisor that fit"), "MiB");
+    QCommandLineOption cliVramBudget("vram-budget", QApplication::translate("main", "device memory budget for clouds, in MiB; picks the largest resolution and layer divisor that fit"), "MiB");
+    QCommandLineOption cliThreads("threads", QApplication::translate("main", "threads used to bake clouds (default: all cores but one, or the saved setting)"), "count");
+    QCommandLineOption cliLayerGrain("layer-grain", QApplication::translate("main", "minimum cloud layers per parallel task (default: 1, or the saved setting)"), "layers");
+    QCommandLineOption cliDataFormat("data-format", QApplication::translate("main", "GPU storage format of cloud PDVs: float32, float16, unorm16, or unorm8 (default: float32)"), "format", "float32");
     qParser.addHelpOption();
     qParser.addVersionOption();
     qParser.addOption(cliVerbose);
@@ -62,6 +70,14 @@ int main(int argc, char* argv[]) {
     qParser.addOption(cliProfiling);
     qParser.addOption(cliTesting);
     qParser.addOption(cliResetGeometry);
+    qParser.addOption(cliDataFormat);
+    qParser.addOption(cliGather);
+    qParser.addOption(cliToleranceIndex);
+    qParser.addOption(cliHugePages);
+    qParser.addOption(cliRamBudget);
+    qParser.addOption(cliVramBudget);
+    qParser.addOption(cliThreads);
+    qParser.addOption(cliLayerGrain);
     qParser.process(app);
 
     // CLI option results
@@ -81,6 +97,47 @@ int main(int argc, char* argv[]) {
         std::cout << "Reset Geometry Enabled" << std::endl;
         mainWindow.resetGeometry();
     }
+    if (qParser.isSet(cliDataFormat)) {
+        const QStringList formats = { "float32", "float16", "unorm16", "unorm8" };
+        qsizetype fmt = formats.indexOf(qParser.value(cliDataFormat).toLower());
+        if (fmt < 0) {
+            std::cout << "Unknown data format \"" << qParser.value(cliDataFormat).toStdString() << "\"; using float32" << std::endl;
+        } else {
+            std::cout << "Cloud Data Format: " << formats[fmt].toStdString() << std::endl;
+            mainWindow.setCloudDataFormat(static_cast<CloudDataFormat>(fmt));
+        }
+    }
+    if (qParser.isSet(cliGather)) {
+        std::cout << "Gathered Cloud Streams Enabled" << std::endl;
+        mainWindow.setCloudGather(true);
+    }
+    if (qParser.isSet(cliToleranceIndex)) {
+        std::cout << "Cloud Tolerance Index Enabled" << std::endl;
+        mainWindow.setCloudToleranceIndex(true);
+    }
+    if (qParser.isSet(cliHugePages)) {
+        std::cout << "Cloud Huge Pages Enabled" << std::endl;
+        bufferHugePages = true;
+    }
+    if (qParser.isSet(cliRamBudget) || qParser.isSet(cliVramBudget)) {
+        uint64_t hostMiB = qParser.value(cliRamBudget).toULongLong();
+        uint64_t deviceMiB = qParser.value(cliVramBudget).toULongLong();
+        std::cout << "Cloud Memory Budget: " << hostMiB << " MiB host, " << deviceMiB << " MiB device (0 = unlimited)" << std::endl;
+        mainWindow.setCloudBudget(hostMiB << 20, deviceMiB << 20);
+    }
+
+    // Cloud bake scheduling: CLI first, then saved settings, which the CLI also updates
+    settings.beginGroup("cloud");
+    if (qParser.isSet(cliThreads)) {
+        settings.setValue("threads", qParser.value(cliThreads).toInt());
+    }
+    if (qParser.isSet(cliLayerGrain)) {
+        settings.setValue("layerGrain", qParser.value(cliLayerGrain).toInt());
+    }
+    CloudManager::setBakeThreads(settings.value("threads", 0).toInt());
+    CloudManager::setLayerGrain(settings.value("layerGrain", 1).toInt());
+    settings.endGroup();
+    std::cout << "Cloud Bake Threads: " << CloudManager::getBakeThreads() << std::endl;
 
     // Platform
     QString arch = QSysInfo::currentCpuArchitecture();
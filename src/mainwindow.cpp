@@ -195,9 +195,27 @@ void MainWindow::showLoading(bool loading) {
         pbLoading->show();
     } else {
         statBar->removeWidget(pbLoading);
+        this->showProgress(0, 0, QString());
     }
 }
 
+/**
+ * @brief Shows the progress of the current job on the loading bar.
+ *
+ * @details
+ * A maximum of 0 returns the bar to its busy indicator, with no text.
+ *
+ * @param value The completed amount of work.
+ * @param maximum The total amount of work, or 0 if unknown.
+ * @param text The text to show on the bar, such as the stage and ETA.
+ */
+void MainWindow::showProgress(int value, int maximum, const QString &text) {
+    pbLoading->setMaximum(maximum);
+    pbLoading->setValue(value);
+    pbLoading->setFormat(text);
+    pbLoading->setTextVisible(!text.isEmpty());
+}
+
 /**
  * @brief Toggles the visibility of the details widget.
  *
@@ -1556,7 +1574,8 @@ void MainWindow::handleButtMorbWaves() {
  *
  * This function is called when the user clicks the "Render Cloud" button in the "Harmonics" dock widget.
  * It reads the input values from the dock widget and sets the properties of the cloud config.
- * It also estimates the buffer sizes required for the new cloud config, and shows a confirmation dialog if the total size exceeds 1 GiB.
+ * It also estimates the peak memory and bake time of the new cloud config, and shows a confirmation dialog if it needs over 1 GiB.
+ * With a memory budget set (--ram-budget, --vram-budget), it instead scales the resolution and layer divisor to fit the budget.
  * If the user confirms, it generates the new cloud and updates the state of the GUI elements.
  */
 void MainWindow::handleButtMorbHarmonics() {
@@ -1574,39 +1593,45 @@ void MainWindow::handleButtMorbHarmonics() {
         mapCloudRecipes.erase(key);
     }
 
-    uint vertex, opt, index;
-    uint64_t total;
-    vkGraph->estimateSize(&mw_cloudConfig, &mapCloudRecipes, &vertex, &opt, &index);
-    total = vertex + opt + index;
-    uint64_t oneGiB = 1024 * 1024 * 1024;
-
-    if (total > oneGiB) {
-        std::array<float, 4> bufs = { static_cast<float>(vertex), static_cast<float>(opt), static_cast<float>(index), static_cast<float>(total) };
-        QStringList units = { " B", "KB", "MB", "GB" };
-        std::array<int, 4> u = { 0, 0, 0, 0 };
-        int div = 1024;
-
-        for (int idx = 0; auto& f : bufs) {
-            while (f > div) {
-                f /= div;
-                u[idx]++;
-            }
-            idx++;
+    // With a memory budget, scale the grid to fit it; otherwise confirm any cloud predicted to need over 1 GiB
+    if (vkGraph->hasCloudBudget()) {
+        if (!vkGraph->fitCloudBudget(&mw_cloudConfig, &mapCloudRecipes)) {
+            QMessageBox::warning(this, "Memory Budget", "No cloud resolution fits within the memory budget.");
+            return;
         }
+        entryCloudLayers->setText(QString::number(mw_cloudConfig.cloudLayDivisor));
+        entryCloudRes->setText(QString::number(mw_cloudConfig.cloudResolution));
+    } else {
+        CloudEstimate est = vkGraph->estimateCloud(&mw_cloudConfig, &mapCloudRecipes);
+        uint64_t oneGiB = 1024 * 1024 * 1024;
+
+        if (est.hostBytes > oneGiB) {
+            std::array<float, 2> bufs = { static_cast<float>(est.hostBytes), static_cast<float>(est.deviceBytes) };
+            QStringList units = { " B", "KB", "MB", "GB" };
+            std::array<int, 2> u = { 0, 0 };
+            int div = 1024;
+
+            for (int idx = 0; auto& f : bufs) {
+                while (f > div) {
+                    f /= div;
+                    u[idx]++;
+                }
+                idx++;
+            }
 
-        QMessageBox dialogConfim(this);
-        QString strDialogConfirm = QString("Estimated buffer sizes: \n"\
-                                           "Vertex:        %1 %4\n"\
-                                           "Data:          %2 %5\n"\
-                                           "Index:         %3 %6\n\n"\
-                                           "Total:         %7 %8"\
-                                          ).arg(bufs[0], 9, 'f', 2, ' ').arg(bufs[1], 9, 'f', 2, ' ').arg(bufs[2], 9, 'f', 2, ' ')\
-                                           .arg(units[u[0]]).arg(units[u[1]]).arg(units[u[2]])\
-                                           .arg(bufs[3], 9, 'f', 2, ' ').arg(units[u[3]]);
-        dialogConfim.setText(strDialogConfirm);
-        dialogConfim.setStandardButtons(QMessageBox::Ok | QMessageBox::Cancel);
-        dialogConfim.setDefaultButton(QMessageBox::Ok);
-        if (dialogConfim.exec() == QMessageBox::Cancel) { return; }
+            QMessageBox dialogConfim(this);
+            QString strDialogConfirm = QString("Estimated cost: \n"\
+                                               "Host (peak):   %1 %3\n"\
+                                               "Device:        %2 %4\n\n"\
+                                               "Bake time:     %5 s"\
+                                              ).arg(bufs[0], 9, 'f', 2, ' ').arg(bufs[1], 9, 'f', 2, ' ')\
+                                               .arg(units[u[0]]).arg(units[u[1]])\
+                                               .arg(est.bakeMs * 0.001, 9, 'f', 1, ' ');
+            dialogConfim.setText(strDialogConfirm);
+            dialogConfim.setStandardButtons(QMessageBox::Ok | QMessageBox::Cancel);
+            dialogConfim.setDefaultButton(QMessageBox::Ok);
+            if (dialogConfim.exec() == QMessageBox::Cancel) { return; }
+        }
     }
 
     vkGraph->newCloudConfig(&this->mw_cloudConfig, &this->mapCloudRecipes, true);
@@ -1779,6 +1804,7 @@ void MainWindow::handleButtColors(int id) {
 void MainWindow::handleSlideCullingX(int val) {
     float pct = (static_cast<float>(val) / static_cast<float>(aStyle.sliderTicks));
     this->mw_cloudConfig.cloudCull_x = pct;
+    this->handleSlideReleased();
 }
 
 /**
@@ -1793,6 +1819,7 @@ void MainWindow::handleSlideCullingX(int val) {
 void MainWindow::handleSlideCullingY(int val) {
     float pct = (static_cast<float>(val) / static_cast<float>(aStyle.sliderTicks));
     this->mw_cloudConfig.cloudCull_y = pct;
+    this->handleSlideReleased();
 }
 
 /**
@@ -1822,13 +1849,15 @@ void MainWindow::handleSlideCullingR(int val) {
     } else if (val > 0) {
         this->mw_cloudConfig.cloudCull_rOut = pct;
     }
+    this->handleSlideReleased();
 }
 
 /**
  * @brief Called when a slider is released.
  *
- * This function is called when the user releases any of the culling sliders in the Cloud Config dock widget.
- * It checks if the value of the slider has changed, and if so, sends the new cloud config to the VKGraph.
+ * This function is called when the user releases any of the culling sliders in the Cloud Config dock widget,
+ * and by each slider handler while dragging. It checks if the value of the slider has changed, and if so,
+ * sends the new cloud config to the VKGraph, whose job queue coalesces rapid updates.
  */
 void MainWindow::handleSlideReleased() {
     if (!activeModel) { return; }
@@ -2075,6 +2104,10 @@ void MainWindow::_initGraphics() {
     }
     
     vkGraph = new VKWindow(this, fileHandler);
+    vkGraph->setCloudDataFormat(cloudDataFormat);
+    vkGraph->setCloudGather(cloudGather);
+    vkGraph->setCloudToleranceIndex(cloudToleranceIndex);
+    vkGraph->setCloudBudget(cloudBudgetHost, cloudBudgetDevice);
     vkGraph->setVulkanInstance(&vkInst);
     graph = QWidget::createWindowContainer(vkGraph);
     graph->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -2122,6 +2155,7 @@ void MainWindow::_connectSignals() {
     // Status Bar
     connect(vkGraph, &VKWindow::detailsChanged, this, &MainWindow::updateDetails);
     connect(vkGraph, &VKWindow::toggleLoading, this, &MainWindow::showLoading);
+    connect(vkGraph, &VKWindow::progressChanged, this, &MainWindow::showProgress);
 
     /* 
      * Config Files
@@ -577,6 +577,10 @@ public:
     void init(QRect &windowSize);
     void postInit();
     void resetGeometry() { this->loadGeometry = false; }
+    void setCloudDataFormat(CloudDataFormat format) { this->cloudDataFormat = format; }
+    void setCloudGather(bool enable) { this->cloudGather = enable; }
+    void setCloudToleranceIndex(bool enable) { this->cloudToleranceIndex = enable; }
+    void setCloudBudget(uint64_t hostBytes, uint64_t deviceBytes) { this->cloudBudgetHost = hostBytes; this->cloudBudgetDevice = deviceBytes; }
 
     AtomixFiles& getAtomixFiles() { return fileHandler->atomixFiles; }
 
@@ -586,6 +590,7 @@ signals:
 public slots:
     void updateDetails(AtomixInfo *info);
     void showLoading(bool loading);
+    void showProgress(int value, int maximum, const QString &text);
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
@@ -740,6 +745,11 @@ private:
     bool showDebug = false;
     bool notDefaultConfig = false;
     bool loadGeometry = true;
+    CloudDataFormat cloudDataFormat = CloudDataFormat::FLOAT32;
+    bool cloudGather = false;
+    bool cloudToleranceIndex = false;
+    uint64_t cloudBudgetHost = 0;
+    uint64_t cloudBudgetDevice = 0;
 
     int mw_baseFontSize = 0;
     
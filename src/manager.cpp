@@ -30,6 +30,7 @@ void Manager::resetManager() {
     allVertices.clear();
     allData.clear();
     allIndices.clear();
+    drawRanges.clear();
 
     this->vertexCount = 0;
     this->vertexSize = 0;
@@ -51,6 +52,125 @@ uint Manager::clearUpdates() {
     return flags;
 }
 
+/*
+ *  Snapshots
+ */
+
+/**
+ * @brief Take the newest published snapshot, if one was published since the last take.
+ *
+ * @details
+ * Called by the render thread, which keeps the snapshot it last took and can upload or
+ * redraw from it while the manager builds the next one. Wait-free: publishSnapshot() and
+ * this function only exchange the single pending pointer.
+ *
+ * @return The snapshot, or null if nothing new was published.
+ */
+std::shared_ptr<const ManagerSnapshot> Manager::takeSnapshot() {
+    return std::shared_ptr<const ManagerSnapshot>(this->snapPending.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+/**
+ * @brief Describe the live buffers as a snapshot, without copying them.
+ *
+ * @details
+ * For managers whose buffers only change while the render thread is not reading them.
+ *
+ * @param flags The UPD_* flags whose buffers to include.
+ * @return A snapshot that is only valid until the manager's buffers next change.
+ */
+ManagerSnapshot Manager::viewBuffers(uint flags) {
+    ManagerSnapshot snap;
+    snap.flags = flags;
+    this->fillSnapshot(snap, flags, false);
+    return snap;
+}
+
+/**
+ * @brief Publish the buffers changed since the last publish as a new immutable snapshot.
+ *
+ * @details
+ * Called by the thread producing the buffers, with its pending UPD_* flags. Buffers so
+ * flagged are lent to the snapshot rather than copied (see lendBuffer()); all others are
+ * shared with the previous snapshot. A snapshot that the render thread has not yet taken
+ * is replaced, and its flags carry over.
+ */
+void Manager::publishSnapshot() {
+    uint flags = this->clearUpdates();
+    ManagerSnapshot *snap = new ManagerSnapshot(this->snapPublished);
+    this->fillSnapshot(*snap, flags, true);
+    this->snapPublished = *snap;
+
+    ManagerSnapshot *stale = this->snapPending.exchange(nullptr, std::memory_order_acq_rel);
+    snap->flags = (stale) ? (flags | stale->flags) : flags;
+    delete stale;
+    this->snapPending.store(snap, std::memory_order_release);
+}
+
+/**
+ * @brief Fill `snap` with the counts and sizes of all buffers, and the data of those flagged.
+ *
+ * @param snap The snapshot to fill.
+ * @param flags The UPD_* flags whose buffers to fill.
+ * @param lend True to lend the buffers to the snapshot until they are next written, False to point at the live ones.
+ */
+void Manager::fillSnapshot(ManagerSnapshot &snap, uint flags, bool lend) {
+    auto view = [](const void *data, uint64_t size) {
+        if (!data || !size) {
+            return std::shared_ptr<const void>();
+        }
+        return std::shared_ptr<const void>(std::shared_ptr<const void>(), data);
+    };
+
+    snap.vertexCount = this->vertexCount;
+    snap.vertexSize = this->vertexSize;
+    snap.vertexOffset = this->vertexOffset;
+    snap.dataCount = this->dataCount;
+    snap.dataSize = this->dataSize;
+    snap.dataOffset = this->dataOffset;
+    snap.colourCount = this->colourCount;
+    snap.colourSize = this->colourSize;
+    snap.colourOffset = this->colourOffset;
+    snap.indexCount = this->indexCount;
+    snap.indexSize = this->indexSize;
+    snap.indexOffset = this->indexOffset;
+
+    if (flags & em::UPD_VBO) {
+        snap.vertexData = (lend) ? lendBuffer(allVertices, vertexLoan, this->vertexSize)
+                                 : view((allVertices.empty()) ? nullptr : &allVertices[0], this->vertexSize);
+    }
+    if (flags & em::UPD_DATA) {
+        snap.dataData = (lend) ? this->lendData() : view((this->dataSize) ? this->getDataData() : nullptr, this->dataSize);
+        snap.colourData = (lend) ? lendBuffer(allColours, colourLoan, this->colourSize)
+                                 : view((allColours.empty()) ? nullptr : &allColours[0], this->colourSize);
+    }
+    if (flags & em::UPD_IBO) {
+        snap.indexData = (lend) ? lendBuffer(allIndices, indexLoan, this->indexSize)
+                                : view((allIndices.empty()) ? nullptr : &allIndices[0], this->indexSize);
+    }
+    if (flags & em::UPD_RANGES) {
+        snap.drawRanges = (lend) ? std::make_shared<const std::vector<DrawRange>>(this->drawRanges)
+                                 : std::shared_ptr<const std::vector<DrawRange>>(std::shared_ptr<const void>(), &this->drawRanges);
+    }
+}
+
+/**
+ * @brief Lend the buffer getDataData() points at to a snapshot.
+ */
+std::shared_ptr<const void> Manager::lendData() {
+    return lendBuffer(allData, dataLoan, this->dataSize);
+}
+
+/**
+ * @brief Take back every lent buffer, so the snapshots still holding them outlive the manager safely.
+ */
+void Manager::reclaimBuffers() {
+    reclaimBuffer(allVertices, vertexLoan, snapPublished.vertexData);
+    reclaimBuffer(allData, dataLoan, snapPublished.dataData);
+    reclaimBuffer(allColours, colourLoan, snapPublished.colourData);
+    reclaimBuffer(allIndices, indexLoan, snapPublished.indexData);
+}
+
 /*
  *  Generators
  */
@@ -148,7 +268,7 @@ const float* Manager::getVertexData() {
     return glm::value_ptr(allVertices.front());
 }
 
-const float* Manager::getDataData() {
+const void* Manager::getDataData() {
     assert(mStatus.hasAll(em::DATA_READY));
     return &allData[0];
 }
@@ -25,12 +25,17 @@
 #ifndef MANAGER_H
 #define MANAGER_H
 
-#include <QMutex>
-#include <QMutexLocker>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
-#include "filehandler.hpp"
+#include "global.hpp"
 
 
 using glm::vec4;
@@ -43,10 +48,90 @@ using vVec4 = std::vector<vec4>;
 // using vVec2 = std::vector<vec2>;
 
 
+/* Whether large buffers are advised as transparent huge pages (Linux only); set once at startup by --huge-pages */
+inline bool bufferHugePages = false;
+
+/**
+ * BufferAllocator
+ *
+ * @brief Allocator for grid-sized buffers that leaves new elements uninitialized.
+ *
+ * @details
+ * resize() only reserves memory, so the parallel stage that fills a buffer is also the
+ * first to touch its pages, instead of a serial zero-fill. Blocks of HUGE_PAGE bytes or
+ * more are aligned to HUGE_PAGE, and advised as huge pages if bufferHugePages is set.
+ */
+template <typename T>
+struct BufferAllocator : std::allocator<T> {
+    using value_type = T;
+    static constexpr size_t HUGE_PAGE = size_t(2) << 20;
+
+    BufferAllocator() noexcept = default;
+    template <typename U> BufferAllocator(const BufferAllocator<U> &) noexcept {}
+    template <typename U> struct rebind { using other = BufferAllocator<U>; };
+
+    T *allocate(size_t n) {
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE) {
+            return std::allocator<T>::allocate(n);
+        }
+        void *block = ::operator new((bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1), std::align_val_t(HUGE_PAGE));
+#ifdef __linux__
+        if (bufferHugePages) {
+            madvise(block, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T *>(block);
+    }
+    void deallocate(T *p, size_t n) noexcept {
+        if (n * sizeof(T) < HUGE_PAGE) {
+            std::allocator<T>::deallocate(p, n);
+        } else {
+            ::operator delete(p, std::align_val_t(HUGE_PAGE));
+        }
+    }
+
+    template <typename U> void construct(U *p) noexcept { ::new (static_cast<void *>(p)) U; }
+    template <typename U, typename... Args> void construct(U *p, Args&&... args) { std::construct_at(p, std::forward<Args>(args)...); }
+};
+template <typename T, typename U>
+bool operator==(const BufferAllocator<T> &, const BufferAllocator<U> &) { return true; }
+
+using fbuf = std::vector<float, BufferAllocator<float>>;
+using vVec4buf = std::vector<vec4, BufferAllocator<vec4>>;
+
+
+/* A manager's published buffers, shared by reference count and never modified after publishing */
+struct ManagerSnapshot {
+    uint flags = 0;                     // UPD_* flags accumulated since the previous snapshot was taken
+    uint64_t vertexCount = 0;
+    uint64_t vertexSize = 0;
+    uint64_t vertexOffset = 0;
+    uint64_t dataCount = 0;
+    uint64_t dataSize = 0;
+    uint64_t dataOffset = 0;
+    uint64_t colourCount = 0;
+    uint64_t colourSize = 0;
+    uint64_t colourOffset = 0;
+    uint64_t indexCount = 0;
+    uint64_t indexSize = 0;
+    uint64_t indexOffset = 0;
+    std::shared_ptr<const void> vertexData;
+    std::shared_ptr<const void> dataData;
+    std::shared_ptr<const void> colourData;
+    std::shared_ptr<const void> indexData;
+    std::shared_ptr<const std::vector<DrawRange>> drawRanges;
+    int gridResolution = 0;             // [Cloud] Vertex grid of the published buffers
+    int gridDivisor = 0;                // [Cloud]
+    uint gridLayers = 0;                // [Cloud] Layers within the tolerance radius
+    bool sliderRanges = false;          // [Cloud] IBO holds the voxel-ordered tolerance cull, so sliders only need draw ranges
+};
+
+
 class Manager {
     public:
         Manager(){};
-        virtual ~Manager(){ resetManager(); };
+        virtual ~Manager(){ reclaimBuffers(); resetManager(); delete snapPending.load(); };
 
         virtual double create() { return 0.0; };
         virtual void update(double time) {m_time = time;};
@@ -67,12 +152,16 @@ class Manager {
         uint getIndexOffset() { return int(this->indexOffset); };
         
         const float* getVertexData();
-        const float* getDataData();
+        virtual const void* getDataData();
         const float* getColourData();
         const uint* getIndexData();
+        const std::vector<DrawRange>& getDrawRanges() { return this->drawRanges; };
 
         bool isCPU() { return this->mStatus.hasAny(em::CPU_RENDER); };
 
+        std::shared_ptr<const ManagerSnapshot> takeSnapshot();
+        ManagerSnapshot viewBuffers(uint flags);
+
         void printIndices();
         void printVertices();
 
@@ -85,6 +174,53 @@ class Manager {
         virtual void genDataBuffer();
         virtual void genColourBuffer();
         virtual void genIndexBuffer();
+
+        void publishSnapshot();
+        virtual void fillSnapshot(ManagerSnapshot &snap, uint flags, bool lend);
+        virtual std::shared_ptr<const void> lendData();
+        void reclaimBuffers();
+
+        /* Lend a buffer to a snapshot instead of copying it; reclaimBuffer() must run before the buffer is next written */
+        template <typename V>
+        static std::shared_ptr<const void> lendBuffer(V &buf, std::weak_ptr<V> &loan, uint64_t size) {
+            if (buf.empty() || !size) {
+                return std::shared_ptr<const void>();
+            }
+            std::shared_ptr<V> holder = loan.lock();
+            if (!holder) {
+                holder = std::make_shared<V>();
+                loan = holder;
+            }
+            return std::shared_ptr<const void>(holder, buf.data());
+        }
+
+        /* Take a lent buffer back before writing it: if a snapshot other than snapPublished still holds it, its
+           storage moves to the snapshot, and True is returned with `buf` left empty; otherwise it is written in place */
+        template <typename V>
+        static bool reclaimBuffer(V &buf, std::weak_ptr<V> &loan, const std::shared_ptr<const void> &published) {
+            std::shared_ptr<V> holder = loan.lock();
+            if (!holder) {
+                return false;
+            }
+            long owners = holder.use_count() - 1 - long(published && (published.get() == static_cast<const void *>(buf.data())));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (owners <= 0) {
+                return false;
+            }
+            holder->swap(buf);
+            loan.reset();
+            return true;
+        }
+
+        /* Resize a buffer to `count` uninitialized elements, reusing its allocation unless over twice `keep` */
+        template <typename V>
+        static void sizeBuffer(V &buf, size_t count, size_t keep = 0) {
+            if (buf.capacity() > (std::max(count, keep) << 1)) {
+                V().swap(buf);
+            }
+            buf.clear();
+            buf.resize(count);
+        }
         
         int setVertexCount();
         int setVertexSize();
@@ -96,14 +232,22 @@ class Manager {
         int setIndexSize();
 
         BitFlag mStatus;
-        QMutex mutex;
+        std::mutex mutex;
         
-        vVec4 allVertices;
+        vVec4buf allVertices;
         dvec dataStaging;
-        fvec allData;
+        fbuf allData;
         vVec4 allColours;
         uvec indicesStaging;
         uvec allIndices;
+        std::vector<DrawRange> drawRanges;
+
+        std::atomic<ManagerSnapshot *> snapPending = nullptr;   // Newest snapshot not yet taken by the render thread
+        ManagerSnapshot snapPublished;                          // Newest snapshot published, for sharing unchanged buffers
+        std::weak_ptr<vVec4buf> vertexLoan;                     // Holders of the buffers lent to snapshots, see lendBuffer()
+        std::weak_ptr<fbuf> dataLoan;
+        std::weak_ptr<vVec4> colourLoan;
+        std::weak_ptr<uvec> indexLoan;
         
         uint64_t vertexCount = 0;
         uint64_t vertexSize = 0;
@@ -141,6 +285,7 @@ class Manager {
             UPD_MATRICES =      1 << 14,    // Needs initVecsAndMatrices() to reset position and view
             CPU_RENDER =        1 << 15,    // CPU rendering
             UPDATE_REQUIRED =   1 << 16,    // An update must execute on next render
+            UPD_RANGES =        1 << 17,    // Draw ranges into the IBO need to be updated
         };
 
         const uint eUpdateFlags = uint(-1) << 5;
@@ -0,0 +1,338 @@
+/**
+ * orbitals.hpp
+ *
+ *    Created on: Jan 6, 2025
+ *   Last Update: Jan 6, 2025
+ *  Orig. Author: Wade Burch (dev@nolnoch.com)
+ *
+ *  Copyright 2025 Wade Burch (GPLv3)
+ *
+ *  This file is part of atomix.
+ *
+ *  atomix is free software: you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation, either version 3 of the License, or (at your option) any later
+ *  version.
+ *
+ *  atomix is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with
+ *  atomix. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBITALS_H
+#define ORBITALS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+
+
+/**
+ * Compile-time specialized orbital kernels for hydrogen-like states with n <= MAX_N.
+ *
+ * Every Laguerre and Legendre polynomial needed for n <= MAX_N has a fixed degree, so its
+ * closed-form coefficients are generated at compile time and evaluated with a fully unrolled
+ * Horner loop. The normalization constants (Z = 1) are likewise baked into constexpr tables.
+ * Runtime code picks a kernel once per (n,l) or (l,m) through the *_BATCH tables and then runs
+ * an inlined inner loop over all inputs, with no per-sample function pointer calls.
+ */
+namespace atomix {
+namespace orbitals {
+
+inline constexpr int MAX_N = 8;
+inline constexpr int MAX_L = MAX_N - 1;
+
+using BatchFn = void(*)(const double *, double *, std::size_t);
+
+/*  Compile-Time Helpers  */
+
+constexpr double factorial(int n) {
+    double prod = 1.0;
+    for (int i = 2; i <= n; i++) {
+        prod *= i;
+    }
+    return prod;
+}
+
+constexpr double binomial(int n, int k) {
+    if (k < 0 || k > n) {
+        return 0.0;
+    }
+    double prod = 1.0;
+    for (int i = 1; i <= k; i++) {
+        prod = prod * (n - k + i) / i;
+    }
+    return prod;
+}
+
+constexpr double sqrt_c(double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    double cur = (x > 1.0) ? x : 1.0;
+    double prev = 0.0;
+    while (cur != prev) {
+        prev = cur;
+        cur = 0.5 * (cur + x / cur);
+    }
+    return cur;
+}
+
+/*  Coefficients -- Laguerre  */
+
+/**
+ * @brief Power-series coefficients of the generalized Laguerre polynomial L_k^a(x).
+ *
+ * @details L_k^a(x) = sum_{i=0}^{k} (-1)^i * C(k+a, k-i) * x^i / i!
+ *
+ * @return Coefficients in ascending powers of x.
+ */
+template <int K, int A>
+constexpr std::array<double, K + 1> laguerreCoeffs() {
+    std::array<double, K + 1> c{};
+    for (int i = 0; i <= K; i++) {
+        double sign = (i & 1) ? -1.0 : 1.0;
+        c[i] = sign * binomial(K + A, K - i) / factorial(i);
+    }
+    return c;
+}
+
+/*  Coefficients -- Legendre  */
+
+/**
+ * @brief Power-series coefficients of d^m/dx^m P_l(x), the polynomial part of P_l^m(x).
+ *
+ * @details P_l(x) = 2^-l * sum_k (-1)^k * C(l,k) * C(2l-2k,l) * x^(l-2k), differentiated m
+ * times. Matches atomix_legendre() in omitting the Condon-Shortley phase, so that
+ * P_l^m(x) = (1-x^2)^(m/2) * Q_l^m(x).
+ *
+ * @return Coefficients in ascending powers of x, degree l-m.
+ */
+template <int L, int M>
+constexpr std::array<double, L - M + 1> legendreCoeffs() {
+    std::array<double, L + 1> p{};
+    double scale = 1.0;
+    for (int i = 0; i < L; i++) {
+        scale *= 0.5;
+    }
+    for (int k = 0; 2 * k <= L; k++) {
+        double sign = (k & 1) ? -1.0 : 1.0;
+        p[L - 2 * k] = sign * scale * binomial(L, k) * binomial(2 * L - 2 * k, L);
+    }
+
+    std::array<double, L - M + 1> c{};
+    for (int j = M; j <= L; j++) {
+        c[j - M] = p[j] * factorial(j) / factorial(j - M);
+    }
+    return c;
+}
+
+/*  Normalization Constants  */
+
+constexpr double normR(int n, int l) {
+    double rho_r = 2.0 / n;
+    return rho_r * sqrt_c(rho_r) * sqrt_c(factorial(n - l - 1) / (2.0 * n * factorial(n + l)));
+}
+
+constexpr double normY(int l, int m) {
+    m = (m < 0) ? -m : m;
+    return sqrt_c(((2 * l + 1) / (4.0 * std::numbers::pi)) * (factorial(l - m) / factorial(l + m)));
+}
+
+inline constexpr auto NORM_R = [] {
+    std::array<double, MAX_N * MAX_N> t{};
+    for (int n = 1; n <= MAX_N; n++) {
+        for (int l = 0; l < n; l++) {
+            t[(n - 1) * MAX_N + l] = normR(n, l);
+        }
+    }
+    return t;
+}();
+
+inline constexpr auto NORM_Y = [] {
+    std::array<double, MAX_N * MAX_N> t{};
+    for (int l = 0; l <= MAX_L; l++) {
+        for (int m = 0; m <= l; m++) {
+            t[l * MAX_N + m] = normY(l, m);
+        }
+    }
+    return t;
+}();
+
+/**
+ * @brief Radial normalization constant N_nl for Z = 1.
+ * @param n The principal quantum number; computed directly above MAX_N.
+ * @param l The orbital angular momentum, 0 <= l < n.
+ * @return The constant, or 0 for an invalid (n,l).
+ */
+constexpr double norm_radial(int n, int l) {
+    if ((n < 1) || (l < 0) || (l >= n)) {
+        return 0.0;
+    }
+    return (n > MAX_N) ? normR(n, l) : NORM_R[(n - 1) * MAX_N + l];
+}
+
+/**
+ * @brief Angular normalization constant N_lm.
+ * @param l The orbital angular momentum; computed directly above MAX_L.
+ * @param m_l The magnetic quantum number; only |m_l| is significant.
+ * @return The constant, or 0 for an invalid (l,m).
+ */
+constexpr double norm_angular(int l, int m_l) {
+    int m = (m_l < 0) ? -m_l : m_l;
+    if ((l < 0) || (m > l)) {
+        return 0.0;
+    }
+    return (l > MAX_L) ? normY(l, m) : NORM_Y[l * MAX_N + m];
+}
+
+/*  Kernels  */
+
+template <int P>
+inline double ipow(double x) {
+    double prod = 1.0;
+    for (int i = 0; i < P; i++) {
+        prod *= x;
+    }
+    return prod;
+}
+
+template <std::size_t S>
+inline double horner(const std::array<double, S> &c, double x) {
+    double sum = c[S - 1];
+    for (int i = static_cast<int>(S) - 2; i >= 0; i--) {
+        sum = sum * x + c[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Closed-form radial wavefunction R_nl(r) for Z = 1.
+ */
+template <int N, int L>
+inline double radial(double r) {
+    static constexpr auto coeffs = laguerreCoeffs<N - L - 1, 2 * L + 1>();
+    static constexpr double norm = normR(N, L);
+    double rho = (2.0 / N) * r;
+    return horner(coeffs, rho) * ipow<L>(rho) * std::exp(-0.5 * rho) * norm;
+}
+
+/**
+ * @brief Closed-form associated Legendre polynomial P_l^m(x), without Condon-Shortley phase.
+ */
+template <int L, int M>
+inline double legendre(double x) {
+    static constexpr auto coeffs = legendreCoeffs<L, M>();
+    double poly = horner(coeffs, x);
+    if constexpr (M == 0) {
+        return poly;
+    } else {
+        double root = std::sqrt(1.0 - x) * std::sqrt(1.0 + x);
+        return ipow<M>(root) * poly;
+    }
+}
+
+template <int N, int L>
+void radialBatch(const double *r, double *out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = radial<N, L>(r[i]);
+    }
+}
+
+template <int L, int M>
+void legendreBatch(const double *x, double *out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = legendre<L, M>(x[i]);
+    }
+}
+
+/*  Dispatch Tables  */
+
+template <std::size_t I>
+constexpr BatchFn radialEntry() {
+    constexpr int n = static_cast<int>(I / MAX_N) + 1;
+    constexpr int l = static_cast<int>(I % MAX_N);
+    if constexpr (l < n) {
+        return &radialBatch<n, l>;
+    } else {
+        return nullptr;
+    }
+}
+
+template <std::size_t I>
+constexpr BatchFn legendreEntry() {
+    constexpr int l = static_cast<int>(I / MAX_N);
+    constexpr int m = static_cast<int>(I % MAX_N);
+    if constexpr (m <= l) {
+        return &legendreBatch<l, m>;
+    } else {
+        return nullptr;
+    }
+}
+
+template <std::size_t... I>
+constexpr std::array<BatchFn, sizeof...(I)> makeRadialTable(std::index_sequence<I...>) {
+    return { radialEntry<I>()... };
+}
+
+template <std::size_t... I>
+constexpr std::array<BatchFn, sizeof...(I)> makeLegendreTable(std::index_sequence<I...>) {
+    return { legendreEntry<I>()... };
+}
+
+inline constexpr auto RADIAL_BATCH = makeRadialTable(std::make_index_sequence<MAX_N * MAX_N>{});
+inline constexpr auto LEGENDRE_BATCH = makeLegendreTable(std::make_index_sequence<MAX_N * MAX_N>{});
+
+/**
+ * @brief Evaluate R_nl at `count` radii with the compiled kernel for (n,l).
+ * @param[in] n The principal quantum number.
+ * @param[in] l The orbital angular momentum, 0 <= l < n.
+ * @param[in] r Radii at which to evaluate.
+ * @param[out] out Destination for `count` results, zeroed for an invalid (n,l).
+ * @param[in] count Number of radii.
+ * @return False if n > MAX_N, which has no compiled kernel and leaves `out` untouched.
+ */
+inline bool radial_batch(int n, int l, const double *r, double *out, std::size_t count) {
+    if (n > MAX_N) {
+        return false;
+    }
+    if ((n < 1) || (l < 0) || (l >= n)) {
+        std::fill(out, out + count, 0.0);
+        return true;
+    }
+    RADIAL_BATCH[(n - 1) * MAX_N + l](r, out, count);
+    return true;
+}
+
+/**
+ * @brief Evaluate P_l^|m| at `count` points with the compiled kernel for (l,|m|).
+ * @param[in] l The orbital angular momentum.
+ * @param[in] m_l The magnetic quantum number; only |m_l| is significant.
+ * @param[in] x Points in [-1, 1], typically cos(phi).
+ * @param[out] out Destination for `count` results, zeroed for an invalid (l,m).
+ * @param[in] count Number of points.
+ * @return False if l > MAX_L, which has no compiled kernel and leaves `out` untouched.
+ */
+inline bool legendre_batch(int l, int m_l, const double *x, double *out, std::size_t count) {
+    int m = (m_l < 0) ? -m_l : m_l;
+    if (l > MAX_L) {
+        return false;
+    }
+    if ((l < 0) || (m > l)) {
+        std::fill(out, out + count, 0.0);
+        return true;
+    }
+    LEGENDRE_BATCH[l * MAX_N + m](x, out, count);
+    return true;
+}
+
+} // namespace orbitals
+} // namespace atomix
+
+#endif
@@ -62,6 +62,9 @@ void ProgramVK::cleanup() {
             delete render;
         }
         model->renders.clear();
+
+        // indirect draw buffers
+        this->destroyDrawBuffers(model);
         
         // pipeline layouts
         delete model->pipeInfo;
@@ -159,6 +162,11 @@ void ProgramVK::setInstance(AtomixDevice *atomixDevice) {
     this->p_phydev = atomixDevice->physicalDevice;
     this->p_vf = this->p_vi->functions();
 
+    // QVulkanWindow enables every supported core feature, so multi-draw indirect is usable wherever it is reported
+    VkPhysicalDeviceFeatures features{};
+    this->p_vf->vkGetPhysicalDeviceFeatures(this->p_phydev, &features);
+    this->p_maxDrawIndirect = (features.multiDrawIndirect) ? this->p_vkw->physicalDeviceProperties()->limits.maxDrawIndirectCount : 1;
+
     // Link Command Pool, Queue, and Render Pass to Qt defaults
     this->p_cmdpool = this->p_vkw->graphicsCommandPool();
     this->p_queue = this->p_vkw->graphicsQueue();
@@ -533,6 +541,9 @@ VKuint ProgramVK::addModel(ModelCreateInfo &info) {
     if (info.ibo->data) {
         this->stageAndCopyBuffer(this->p_buffers.back(), this->p_buffersMemory.back(), BufferType::INDEX, info.ibo->size, info.ibo->data);
         model->valid.ibo = true;
+    } else if (info.ibo->count) {
+        // Count only, for renders drawn without indices
+        model->valid.ibo = true;
     }
 
     // Pipeline Model Setup
@@ -610,6 +621,7 @@ VKuint ProgramVK::addModel(ModelCreateInfo &info) {
         
         render->indexOffset = off.offset;
         render->indexCount = indexCount[i];
+        render->indexed = off.indexed;
         
         if (info.pushConstant.empty()) {
             render->pushConst = -1;
@@ -1920,6 +1932,13 @@ void ProgramVK::updateBuffer(BufferUpdateInfo &info) {
 void ProgramVK::_updateBuffer(const VKuint idx, BufferCreateInfo *bufferInfo, ModelInfo *model, const BufferType type, const VKuint64 offset, const VKuint64 count, const VKuint64 size, const void *data) {
     bool isVBO = (type == BufferType::VERTEX || type == BufferType::DATA);
     bool isIBO = (type == BufferType::INDEX);
+
+    if (isIBO && !data) {
+        // Count-only update: the IBO contents are unchanged, or unused by renders drawn without indices
+        this->setIndexRange(model, offset, count);
+        model->valid.ibo = true;
+        return;
+    }
     
     if (!bufferInfo->data) {
         // Model was pre-declared and needs to be updated for initialization
@@ -1992,21 +2011,126 @@ void ProgramVK::_updateBuffer(const VKuint idx, BufferCreateInfo *bufferInfo, Mo
         }
 
         if (isIBO) {
-            if (model->activePrograms.size() != 0) {
-                for (auto &prog : model->activePrograms) {
-                    for (auto &renderIdx : model->programs[prog].offsets) {
-                        model->renders[renderIdx]->indexOffset = offset;
-                        model->renders[renderIdx]->indexCount = count;
-                    }
-                }
-            } else {
-                for (auto &render : model->renders) {
-                    render->indexOffset = offset;
-                    render->indexCount = count;
-                }
+            this->setIndexRange(model, offset, count);
+        }
+    }
+}
+
+/**
+ * @brief Set the index offset and count drawn by a model's active renders.
+ *
+ * @details
+ * If the model has no active programs yet, every render is updated.
+ *
+ * @param model - the model to update
+ * @param offset - the first index to draw
+ * @param count - the number of indices (or vertices, for renders drawn without indices) to draw
+ */
+void ProgramVK::setIndexRange(ModelInfo *model, const VKuint64 offset, const VKuint64 count) {
+    if (model->activePrograms.size() != 0) {
+        for (auto &prog : model->activePrograms) {
+            for (auto &renderIdx : model->programs[prog].offsets) {
+                model->renders[renderIdx]->indexOffset = offset;
+                model->renders[renderIdx]->indexCount = count;
             }
         }
+    } else {
+        for (auto &render : model->renders) {
+            render->indexOffset = offset;
+            render->indexCount = count;
+        }
+    }
+}
+
+/**
+ * @brief Restrict a model's draws to a set of ranges within its index buffer.
+ *
+ * @details
+ * Lets a model hide parts of its index buffer without rebuilding or re-uploading it.
+ * The ranges are recorded as VkDrawIndexedIndirectCommands and drawn by render() with a
+ * single indirect multi-draw where the device supports one, or with one vkCmdDrawIndexed
+ * per range otherwise. An empty list restores the default full-range draw.
+ *
+ * @param modelName The name of the model.
+ * @param ranges Index ranges into the model's IBO, in indices.
+ * @return true if the model was found, false otherwise.
+ */
+bool ProgramVK::updateDrawRanges(const std::string &modelName, const std::vector<DrawRange> &ranges) {
+    VKint id = getModelIdFromName(modelName);
+    if (id < 0) {
+        return false;
+    }
+    ModelInfo *model = this->p_models[id];
+
+    model->draws.commands.resize(ranges.size());
+    std::transform(ranges.cbegin(), ranges.cend(), model->draws.commands.begin(), [](const DrawRange &range) {
+        return VkDrawIndexedIndirectCommand{ range.count, 1, range.first, 0, 0 };
+    });
+    model->draws.stamp++;
+
+    return true;
+}
+
+/**
+ * @brief Copy a model's draw ranges into its indirect buffer for the current frame.
+ *
+ * @details
+ * Each frame in flight has its own persistently mapped buffer, which QVulkanWindow
+ * guarantees the GPU has finished with by the time the frame is recorded again. The
+ * buffer is only rewritten when the ranges have changed since that frame last used it,
+ * and is regrown (doubling) when they no longer fit.
+ *
+ * @param model The model whose draw ranges to stage.
+ * @return The indirect buffer to draw from.
+ */
+VkBuffer ProgramVK::stageDrawRanges(ModelInfo *model) {
+    DrawRangeInfo &draws = model->draws;
+    VKuint frame = this->p_vkw->currentFrame();
+    if (draws.buffers.size() != MAX_FRAMES_IN_FLIGHT) {
+        draws.buffers.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+        draws.memory.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+        draws.mappings.resize(MAX_FRAMES_IN_FLIGHT, nullptr);
+        draws.capacity.resize(MAX_FRAMES_IN_FLIGHT, 0);
+        draws.stamps.resize(MAX_FRAMES_IN_FLIGHT, 0);
+    }
+
+    VKuint64 bytes = draws.commands.size() * sizeof(VkDrawIndexedIndirectCommand);
+    if (draws.capacity[frame] < bytes) {
+        if (draws.buffers[frame] != VK_NULL_HANDLE) {
+            this->p_vdf->vkDestroyBuffer(this->p_dev, draws.buffers[frame], nullptr);
+            this->p_vdf->vkFreeMemory(this->p_dev, draws.memory[frame], nullptr);
+        }
+        draws.capacity[frame] = std::max(bytes, draws.capacity[frame] << 1);
+        createBuffer(draws.capacity[frame], VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), draws.buffers[frame], draws.memory[frame]);
+        this->p_vdf->vkMapMemory(this->p_dev, draws.memory[frame], 0, draws.capacity[frame], 0, &draws.mappings[frame]);
+        draws.stamps[frame] = 0;
+    }
+    if (draws.stamps[frame] != draws.stamp) {
+        memcpy(draws.mappings[frame], draws.commands.data(), bytes);
+        draws.stamps[frame] = draws.stamp;
     }
+
+    return draws.buffers[frame];
+}
+
+/**
+ * @brief Destroy a model's indirect draw buffers.
+ *
+ * @param model The model whose buffers to destroy.
+ */
+void ProgramVK::destroyDrawBuffers(ModelInfo *model) {
+    DrawRangeInfo &draws = model->draws;
+    for (uint i = 0; i < draws.buffers.size(); i++) {
+        if (draws.buffers[i] != VK_NULL_HANDLE) {
+            this->p_vdf->vkDestroyBuffer(this->p_dev, draws.buffers[i], nullptr);
+            this->p_vdf->vkFreeMemory(this->p_dev, draws.memory[i], nullptr);
+        }
+    }
+    draws.buffers.clear();
+    draws.memory.clear();
+    draws.mappings.clear();
+    draws.capacity.clear();
+    draws.stamps.clear();
 }
 
 /**
@@ -2100,7 +2224,9 @@ void ProgramVK::updateSwapExtent(int x, int y) {
  * 
  * Rendering is done by iterating over the models in the active models list,
  * then iterating over the active programs for each model, and finally iterating
- * over the described renders ("offsets") for each program.
+ * over the described renders ("offsets") for each program. Models with draw ranges
+ * (see updateDrawRanges()) draw only those ranges of their index buffer. Renders
+ * declared without indices (OffsetInfo::indexed) draw the same ranges of their VBOs.
  *
  * @param renderExtent The extent of the swap chain image.
  */
@@ -2144,6 +2270,9 @@ void ProgramVK::render(VkExtent2D &renderExtent) {
         if (model->valid.suspended) {
             continue;
         }
+        VKuint64 drawCount = model->draws.commands.size();
+        bool drawIndirect = (drawCount > 1) && (drawCount <= this->p_maxDrawIndirect);
+        VkBuffer drawBuffer = (drawIndirect) ? this->stageDrawRanges(model) : VK_NULL_HANDLE;
 
         for (auto &prog : model->activePrograms) {
             for (auto &renderIdx : model->programs[prog].offsets) {
@@ -2158,11 +2287,33 @@ void ProgramVK::render(VkExtent2D &renderExtent) {
                 this->p_vdf->vkCmdSetViewport(cmdBuff, 0, 1, &this->p_viewport);
                 this->p_vdf->vkCmdSetScissor(cmdBuff, 0, 1, &this->p_scissor);
                 this->p_vdf->vkCmdBindVertexBuffers(cmdBuff, 0, render->vbos.size(), renderVbos.data(), render->vboOffsets.data());
-                this->p_vdf->vkCmdBindIndexBuffer(cmdBuff, this->p_buffers[model->ibo], 0, VK_INDEX_TYPE_UINT32);
                 if (render->pushConst >= 0) {
                     this->p_vdf->vkCmdPushConstants(cmdBuff, this->p_pipeLayouts[model->pipeLayouts[render->pipeLayoutIndex]], VK_SHADER_STAGE_VERTEX_BIT, 0, this->p_pushConsts[render->pushConst].first, this->p_pushConsts[render->pushConst].second);
                 }
-                this->p_vdf->vkCmdDrawIndexed(cmdBuff, render->indexCount, 1, render->indexOffset, 0, 0);
+                if (!render->indexed) {
+                    // Draw ranges index the VBOs directly; a VkDrawIndexedIndirectCommand read at its own
+                    // stride is a valid VkDrawIndirectCommand, with vertexOffset (0) as firstInstance
+                    if (!drawCount) {
+                        this->p_vdf->vkCmdDraw(cmdBuff, render->indexCount, 1, render->indexOffset, 0);
+                    } else if (drawIndirect) {
+                        this->p_vdf->vkCmdDrawIndirect(cmdBuff, drawBuffer, 0, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+                    } else {
+                        for (auto &draw : model->draws.commands) {
+                            this->p_vdf->vkCmdDraw(cmdBuff, draw.indexCount, 1, draw.firstIndex, 0);
+                        }
+                    }
+                    continue;
+                }
+                this->p_vdf->vkCmdBindIndexBuffer(cmdBuff, this->p_buffers[model->ibo], 0, VK_INDEX_TYPE_UINT32);
+                if (!drawCount) {
+                    this->p_vdf->vkCmdDrawIndexed(cmdBuff, render->indexCount, 1, render->indexOffset, 0, 0);
+                } else if (drawIndirect) {
+                    this->p_vdf->vkCmdDrawIndexedIndirect(cmdBuff, drawBuffer, 0, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+                } else {
+                    for (auto &draw : model->draws.commands) {
+                        this->p_vdf->vkCmdDrawIndexed(cmdBuff, draw.indexCount, 1, draw.firstIndex, 0, 0);
+                    }
+                }
             }
         }
     }
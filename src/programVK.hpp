@@ -93,7 +93,10 @@ enum class DataType : uint32_t {
     DOUBLE_VEC4     = 15,
     FLOAT_MAT2      = 16,
     FLOAT_MAT3      = 17,
-    FLOAT_MAT4      = 18
+    FLOAT_MAT4      = 18,
+    HALF            = 19,
+    UNORM16         = 20,
+    UNORM8          = 21
 };
 
 enum class BufferType : unsigned int {
@@ -156,6 +159,7 @@ struct OffsetInfo {
     VKuint bufferComboIndex = 0;
     VKint pushConstantIndex = -1;
     VKtuple offsetLibs = VKtuple(0, 0, 0);
+    bool indexed = true;                // False: draw the VBOs in order, using the IBO count only
 };
 
 struct ModelCreateInfo {
@@ -206,6 +210,17 @@ struct RenderInfo {
     VKuint pipeLayoutIndex = 0;
     VkDeviceSize indexOffset = 0;
     uint64_t indexCount = 0;
+    bool indexed = true;
+};
+
+struct DrawRangeInfo {
+    std::vector<VkDrawIndexedIndirectCommand> commands;     // Empty: each render draws its full index range
+    uint64_t stamp = 0;
+    std::vector<VkBuffer> buffers;                          // Per frame in flight, for indirect draws
+    std::vector<VkDeviceMemory> memory;
+    std::vector<void *> mappings;
+    std::vector<uint64_t> capacity;
+    std::vector<uint64_t> stamps;
 };
 
 struct ValidityInfo {
@@ -233,6 +248,7 @@ struct ModelInfo {
     std::vector<RenderInfo *> renders;
     std::vector<ProgramInfo> programs;
     std::set<VKuint> activePrograms;
+    DrawRangeInfo draws;
     ValidityInfo valid;
 };
 
@@ -304,6 +320,7 @@ public:
 
     void updateBuffer(std::string bufferName, VKuint64 offset, VKuint64 count, VKuint64 size, const void *data);
     void updateBuffer(BufferUpdateInfo &info);
+    bool updateDrawRanges(const std::string &modelName, const std::vector<DrawRange> &ranges);
     void updateUniformBuffer(uint32_t currentImage, std::string uboName, VKuint uboSize, const void *uboData);
     void updatePushConstant(std::string name, const void *data, VKuint size = 0);
     void updateClearColor(float r, float g, float b, float a);
@@ -328,7 +345,10 @@ public:
 
 
 private:
+    VkBuffer stageDrawRanges(ModelInfo *model);
+    void destroyDrawBuffers(ModelInfo *model);
     void _updateBuffer(const VKuint idx, BufferCreateInfo *bufferInfo, ModelInfo *model, const BufferType type, const VKuint64 offset, const VKuint64 count, const VKuint64 size, const void *data);
+    void setIndexRange(ModelInfo *model, const VKuint64 offset, const VKuint64 count);
 
     const uint MAX_FRAMES_IN_FLIGHT = QVulkanWindow::MAX_CONCURRENT_FRAME_COUNT;
 
@@ -393,9 +413,10 @@ private:
     VkResult err = VK_SUCCESS;
     
     bool p_libEnabled = false;
+    VKuint p_maxDrawIndirect = 1;
     VKint p_stage = 0;
 
-    std::array<unsigned int, 19> dataSizes = {
+    std::array<unsigned int, 22> dataSizes = {
         sizeof(float),
         sizeof(float) * 2,
         sizeof(float) * 3,
@@ -414,10 +435,13 @@ private:
         sizeof(double) * 4,
         sizeof(glm::mat2),
         sizeof(glm::mat3),
-        sizeof(glm::mat4)
+        sizeof(glm::mat4),
+        sizeof(uint16_t),
+        sizeof(uint16_t),
+        sizeof(uint8_t)
     };
 
-    std::array<VkFormat, 16> dataFormats = {
+    std::array<VkFormat, 22> dataFormats = {
         VK_FORMAT_R32_SFLOAT,
         VK_FORMAT_R32G32_SFLOAT,
         VK_FORMAT_R32G32B32_SFLOAT,
@@ -433,7 +457,13 @@ private:
         VK_FORMAT_R64_SFLOAT,
         VK_FORMAT_R64G64_SFLOAT,
         VK_FORMAT_R64G64B64_SFLOAT,
-        VK_FORMAT_R64G64B64A64_SFLOAT
+        VK_FORMAT_R64G64B64A64_SFLOAT,
+        VK_FORMAT_UNDEFINED,                // Matrices are not vertex attribute formats
+        VK_FORMAT_UNDEFINED,
+        VK_FORMAT_UNDEFINED,
+        VK_FORMAT_R16_SFLOAT,               // Read as float in shaders
+        VK_FORMAT_R16_UNORM,
+        VK_FORMAT_R8_UNORM
     };
 
     std::map<VkFormat, VKuint> dataFormatIdx = {
@@ -452,10 +482,13 @@ private:
         { VK_FORMAT_R64_SFLOAT, 12 },
         { VK_FORMAT_R64G64_SFLOAT, 13 },
         { VK_FORMAT_R64G64B64_SFLOAT, 14 },
-        { VK_FORMAT_R64G64B64A64_SFLOAT, 15}
+        { VK_FORMAT_R64G64B64A64_SFLOAT, 15},
+        { VK_FORMAT_R16_SFLOAT, 19 },
+        { VK_FORMAT_R16_UNORM, 20 },
+        { VK_FORMAT_R8_UNORM, 21 }
     };
 
-    std::array<std::string, 19> dataTypeNames = {
+    std::array<std::string, 22> dataTypeNames = {
         "float",
         "fvec2",
         "fvec3",
@@ -474,7 +507,10 @@ private:
         "dvec4",
         "mat2",
         "mat3",
-        "mat4"
+        "mat4",
+        "half",
+        "unorm16",
+        "unorm8"
     };
 
     std::array<std::string, 5> bufferTypeNames = {
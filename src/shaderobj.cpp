@@ -31,6 +31,39 @@
 #include "shaderobj.hpp"
 
 
+/**
+ * Resolves `#include "file"` in shader sources against the directory of the
+ * including shader, so shaders can share code (GL_GOOGLE_include_directive).
+ */
+class ShaderIncluder : public glslang::TShader::Includer {
+public:
+    explicit ShaderIncluder(const std::string &dir) : shaderDir(dir) {}
+
+    IncludeResult* includeLocal(const char *headerName, const char *, size_t) override {
+        std::string path = this->shaderDir + headerName;
+        std::ifstream headerFile(path);
+        if (!headerFile.is_open()) {
+            return nullptr;
+        }
+
+        std::ostringstream buffer;
+        buffer << headerFile.rdbuf();
+        std::string *source = new std::string(buffer.str());
+        return new IncludeResult(path, source->c_str(), source->size(), source);
+    }
+
+    void releaseInclude(IncludeResult *result) override {
+        if (result) {
+            delete static_cast<std::string *>(result->userData);
+            delete result;
+        }
+    }
+
+private:
+    std::string shaderDir;
+};
+
+
 /**
  * Primary Constructor.
  */
@@ -100,7 +133,8 @@ bool Shader::compile(uint32_t version) {
     shader.setEntryPoint("main");
     shader.setSourceEntryPoint("main");
     const TBuiltInResource *builtinResource = GetDefaultResources();
-    if (!shader.parse(builtinResource, 450, ECoreProfile, false, false, messages)) {
+    ShaderIncluder includer(this->filePath.substr(0, this->filePath.find_last_of('/') + 1));
+    if (!shader.parse(builtinResource, 450, ECoreProfile, false, false, messages, includer)) {
         std::cout << "Failed to parse shader: " << this->filePath << std::endl;
         std::cout << "Error log: " << std::endl;
         std::cout << shader.getInfoLog() << std::endl;
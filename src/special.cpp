@@ -29,6 +29,18 @@
 
 #include "special.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define ATOMIX_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ATOMIX_TARGET(isa)
+#else
+#define ATOMIX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
 
 double atomix::special::_a_poly_laguerre(unsigned int n, double m, double x) {
     assert(x > 0);
@@ -154,4 +166,335 @@ double atomix::special::_a_assoc_legendre_p(unsigned int l, unsigned int m, doub
     }
 }
 
+/**
+ * @brief Fill a triangular table with P_l^m(x) for every l <= l_max and m <= l in one sweep.
+ *
+ * @details
+ * Walks the diagonal P_m^m = (2m-1) * sqrt(1-x^2) * P_(m-1)^(m-1) once, and from each
+ * diagonal entry runs the upward recurrence in l, so every entry costs O(1) and the whole
+ * table O(l_max^2). This shares all of the work that _a_assoc_legendre_p() repeats for
+ * each (l,m) it is called with. Phase convention matches _a_assoc_legendre_p().
+ *
+ * @param[in] l_max The highest degree to compute.
+ * @param[in] x The argument, in [-1, 1].
+ * @param[out] out Table of atomix_legendre_size(l_max) entries, indexed by atomix_legendre_idx(l, m).
+ */
+void atomix::special::_a_assoc_legendre_p_all(unsigned int l_max, double x, double *out) {
+    double root = std::sqrt(1.0 - x) * std::sqrt(1.0 + x);
+    double p_mm = 1.0;
+
+    for (unsigned int m = 0; m <= l_max; ++m) {
+        if (m > 0) {
+            p_mm *= double(2 * m - 1) * root;
+        }
+        out[atomix_legendre_idx(m, m)] = p_mm;
+        if (m == l_max) {
+            break;
+        }
+
+        double p_lm2m = p_mm;
+        double p_lm1m = double(2 * m + 1) * x * p_mm;
+        out[atomix_legendre_idx(m + 1, m)] = p_lm1m;
+
+        for (unsigned int l = m + 2; l <= l_max; ++l) {
+            double p_lm = (double(2 * l - 1) * x * p_lm1m - double(l + m - 1) * p_lm2m) / double(l - m);
+            out[atomix_legendre_idx(l, m)] = p_lm;
+            p_lm2m = p_lm1m;
+            p_lm1m = p_lm;
+        }
+    }
+}
+
+
+/*
+ *  Batch Kernels
+ */
+
+/**
+ * @brief Detect (once) the widest SIMD instruction set usable on the running CPU.
+ *
+ * @return SimdLevel::AVX512, SimdLevel::AVX2 (with FMA), or SimdLevel::SCALAR.
+ */
+atomix::special::SimdLevel atomix::special::simd_level() {
+    static const SimdLevel level = []() {
+#if defined(ATOMIX_SIMD_X86) && defined(_MSC_VER)
+        int info[4] = { 0, 0, 0, 0 };
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool fma = (info[2] & (1 << 12)) != 0;
+        if (!osxsave) {
+            return SimdLevel::SCALAR;
+        }
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        bool avx512 = (info[1] & (1 << 16)) != 0;
+        if (avx512 && ((xcr0 & 0xE6) == 0xE6)) {
+            return SimdLevel::AVX512;
+        } else if (avx2 && fma && ((xcr0 & 0x6) == 0x6)) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SCALAR;
+#elif defined(ATOMIX_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::AVX512;
+        } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SCALAR;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }();
+    return level;
+}
+
+/**
+ * @brief Name of the SIMD level in use, for profiling output.
+ */
+const char* atomix::special::simd_level_name() {
+    switch (simd_level()) {
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        default:
+            return "Scalar";
+    }
+}
+
+namespace {
+
+/*  Scalar kernels -- same recurrences as the single-x functions above, minus the per-x branching  */
+
+void laguerre_scalar(unsigned int n, double m, const double *x, double *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        double l_n2 = 1.0;
+        double l_n1 = 1.0 + m - x[i];
+        double l_n = (n == 0) ? l_n2 : l_n1;
+        for (unsigned int nn = 2; nn <= n; ++nn) {
+            l_n = ((double(2 * nn - 1) + m - x[i]) * l_n1 - (double(nn - 1) + m) * l_n2) / double(nn);
+            l_n2 = l_n1;
+            l_n1 = l_n;
+        }
+        out[i] = l_n;
+    }
+}
+
+void legendre_scalar(unsigned int l, unsigned int m, const double *x, double *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = atomix::special::_a_assoc_legendre_p(l, m, x[i]);
+    }
+}
+
+#ifdef ATOMIX_SIMD_X86
+
+/*  AVX2 kernels -- 4 doubles per lane group  */
+
+ATOMIX_TARGET("avx2,fma")
+size_t laguerre_avx2(unsigned int n, double m, const double *x, double *out, size_t count) {
+    const __m256d vOne = _mm256_set1_pd(1.0);
+    const __m256d vM = _mm256_set1_pd(m);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d l_n2 = vOne;
+        __m256d l_n1 = _mm256_sub_pd(_mm256_add_pd(vOne, vM), vx);
+        __m256d l_n = (n == 0) ? l_n2 : l_n1;
+        for (unsigned int nn = 2; nn <= n; ++nn) {
+            __m256d a = _mm256_sub_pd(_mm256_set1_pd(double(2 * nn - 1) + m), vx);
+            __m256d b = _mm256_set1_pd(double(nn - 1) + m);
+            l_n = _mm256_fmsub_pd(a, l_n1, _mm256_mul_pd(b, l_n2));
+            l_n = _mm256_mul_pd(l_n, _mm256_set1_pd(1.0 / double(nn)));
+            l_n2 = l_n1;
+            l_n1 = l_n;
+        }
+        _mm256_storeu_pd(out + i, l_n);
+    }
+    return i;
+}
+
+ATOMIX_TARGET("avx2,fma")
+size_t legendre_avx2(unsigned int l, unsigned int m, const double *x, double *out, size_t count) {
+    const __m256d vOne = _mm256_set1_pd(1.0);
+    const __m256d vTwo = _mm256_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d p_l;
+        if (m == 0) {
+            __m256d p_lm2 = vOne;
+            __m256d p_lm1 = vx;
+            p_l = (l == 0) ? p_lm2 : p_lm1;
+            for (unsigned int ll = 2; ll <= l; ++ll) {
+                __m256d xp = _mm256_mul_pd(vx, p_lm1);
+                __m256d t = _mm256_mul_pd(_mm256_sub_pd(xp, p_lm2), _mm256_set1_pd(1.0 / double(ll)));
+                p_l = _mm256_sub_pd(_mm256_fmsub_pd(vTwo, xp, p_lm2), t);
+                p_lm2 = p_lm1;
+                p_lm1 = p_l;
+            }
+        } else {
+            __m256d root = _mm256_mul_pd(_mm256_sqrt_pd(_mm256_sub_pd(vOne, vx)), _mm256_sqrt_pd(_mm256_add_pd(vOne, vx)));
+            __m256d p_mm = vOne;
+            double fact = 1.0;
+            for (unsigned int k = 1; k <= m; ++k) {
+                p_mm = _mm256_mul_pd(p_mm, _mm256_mul_pd(_mm256_set1_pd(fact), root));
+                fact += 2.0;
+            }
+            __m256d p_lm2m = p_mm;
+            __m256d p_lm1m = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(double(2 * m + 1)), vx), p_mm);
+            p_l = (l == m) ? p_lm2m : p_lm1m;
+            for (unsigned int j = m + 2; j <= l; ++j) {
+                __m256d a = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(double(2 * j - 1)), vx), p_lm1m);
+                p_l = _mm256_fnmadd_pd(_mm256_set1_pd(double(j + m - 1)), p_lm2m, a);
+                p_l = _mm256_div_pd(p_l, _mm256_set1_pd(double(j - m)));
+                p_lm2m = p_lm1m;
+                p_lm1m = p_l;
+            }
+        }
+        _mm256_storeu_pd(out + i, p_l);
+    }
+    return i;
+}
+
+/*  AVX-512 kernels -- 8 doubles per lane group  */
+
+ATOMIX_TARGET("avx512f")
+size_t laguerre_avx512(unsigned int n, double m, const double *x, double *out, size_t count) {
+    const __m512d vOne = _mm512_set1_pd(1.0);
+    const __m512d vM = _mm512_set1_pd(m);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d l_n2 = vOne;
+        __m512d l_n1 = _mm512_sub_pd(_mm512_add_pd(vOne, vM), vx);
+        __m512d l_n = (n == 0) ? l_n2 : l_n1;
+        for (unsigned int nn = 2; nn <= n; ++nn) {
+            __m512d a = _mm512_sub_pd(_mm512_set1_pd(double(2 * nn - 1) + m), vx);
+            __m512d b = _mm512_set1_pd(double(nn - 1) + m);
+            l_n = _mm512_fmsub_pd(a, l_n1, _mm512_mul_pd(b, l_n2));
+            l_n = _mm512_mul_pd(l_n, _mm512_set1_pd(1.0 / double(nn)));
+            l_n2 = l_n1;
+            l_n1 = l_n;
+        }
+        _mm512_storeu_pd(out + i, l_n);
+    }
+    return i;
+}
+
+ATOMIX_TARGET("avx512f")
+size_t legendre_avx512(unsigned int l, unsigned int m, const double *x, double *out, size_t count) {
+    const __m512d vOne = _mm512_set1_pd(1.0);
+    const __m512d vTwo = _mm512_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d p_l;
+        if (m == 0) {
+            __m512d p_lm2 = vOne;
+            __m512d p_lm1 = vx;
+            p_l = (l == 0) ? p_lm2 : p_lm1;
+            for (unsigned int ll = 2; ll <= l; ++ll) {
+                __m512d xp = _mm512_mul_pd(vx, p_lm1);
+                __m512d t = _mm512_mul_pd(_mm512_sub_pd(xp, p_lm2), _mm512_set1_pd(1.0 / double(ll)));
+                p_l = _mm512_sub_pd(_mm512_fmsub_pd(vTwo, xp, p_lm2), t);
+                p_lm2 = p_lm1;
+                p_lm1 = p_l;
+            }
+        } else {
+            __m512d root = _mm512_mul_pd(_mm512_sqrt_pd(_mm512_sub_pd(vOne, vx)), _mm512_sqrt_pd(_mm512_add_pd(vOne, vx)));
+            __m512d p_mm = vOne;
+            double fact = 1.0;
+            for (unsigned int k = 1; k <= m; ++k) {
+                p_mm = _mm512_mul_pd(p_mm, _mm512_mul_pd(_mm512_set1_pd(fact), root));
+                fact += 2.0;
+            }
+            __m512d p_lm2m = p_mm;
+            __m512d p_lm1m = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(double(2 * m + 1)), vx), p_mm);
+            p_l = (l == m) ? p_lm2m : p_lm1m;
+            for (unsigned int j = m + 2; j <= l; ++j) {
+                __m512d a = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(double(2 * j - 1)), vx), p_lm1m);
+                p_l = _mm512_fnmadd_pd(_mm512_set1_pd(double(j + m - 1)), p_lm2m, a);
+                p_l = _mm512_div_pd(p_l, _mm512_set1_pd(double(j - m)));
+                p_lm2m = p_lm1m;
+                p_lm1m = p_l;
+            }
+        }
+        _mm512_storeu_pd(out + i, p_l);
+    }
+    return i;
+}
+
+#endif
+
+}
+
+/**
+ * @brief Evaluate the generalized Laguerre polynomial L_n^m for an array of arguments.
+ *
+ * @details
+ * Uses the upward recurrence in n on every element, dispatched to AVX-512/AVX2 when
+ * available and finished with the scalar kernel for the remainder. Negative m falls
+ * back to _a_poly_laguerre() per element, which handles the alternate-series cases.
+ *
+ * @param[in] n The degree of the polynomial.
+ * @param[in] m The order (alpha) of the polynomial.
+ * @param[in] x The arguments to evaluate at.
+ * @param[out] out The results, one per argument.
+ * @param[in] count The number of arguments.
+ */
+void atomix::special::_a_poly_laguerre_batch(unsigned int n, double m, const double *x, double *out, size_t count) {
+    if (m < 0.0) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = _a_poly_laguerre(n, m, x[i]);
+        }
+        return;
+    }
 
+    size_t done = 0;
+#ifdef ATOMIX_SIMD_X86
+    switch (simd_level()) {
+        case SimdLevel::AVX512:
+            done = laguerre_avx512(n, m, x, out, count);
+            break;
+        case SimdLevel::AVX2:
+            done = laguerre_avx2(n, m, x, out, count);
+            break;
+        default:
+            break;
+    }
+#endif
+    laguerre_scalar(n, m, x + done, out + done, count - done);
+}
+
+/**
+ * @brief Evaluate the associated Legendre polynomial P_l^m for an array of arguments.
+ *
+ * @details
+ * Uses the same recurrences as _a_assoc_legendre_p(), dispatched to AVX-512/AVX2 when
+ * available and finished with the scalar function for the remainder.
+ *
+ * @param[in] l The degree of the polynomial.
+ * @param[in] m The order of the polynomial.
+ * @param[in] x The arguments to evaluate at, in [-1, 1].
+ * @param[out] out The results, one per argument.
+ * @param[in] count The number of arguments.
+ */
+void atomix::special::_a_assoc_legendre_p_batch(unsigned int l, unsigned int m, const double *x, double *out, size_t count) {
+    assert(l >= m);
+    size_t done = 0;
+#ifdef ATOMIX_SIMD_X86
+    switch (simd_level()) {
+        case SimdLevel::AVX512:
+            done = legendre_avx512(l, m, x, out, count);
+            break;
+        case SimdLevel::AVX2:
+            done = legendre_avx2(l, m, x, out, count);
+            break;
+        default:
+            break;
+    }
+#endif
+    legendre_scalar(l, m, x + done, out + done, count - done);
+}
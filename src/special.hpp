@@ -25,6 +25,8 @@
 #ifndef SPECIAL_H
 #define SPECIAL_H
 
+#include <cstddef>
+
 
 namespace atomix {
 namespace special {
@@ -41,6 +43,41 @@ inline double atomix_legendre(unsigned int l, unsigned int m, double x) {
     return _a_assoc_legendre_p(l, m, x);
 }
 
+/* All-degree variant fills a triangular table of P_l^m(x) for every l <= l_max and m <= l,
+   stored at index atomix_legendre_idx(l, m). The table must hold atomix_legendre_size(l_max). */
+constexpr unsigned int atomix_legendre_idx(unsigned int l, unsigned int m) {
+    return ((l * (l + 1)) >> 1) + m;
+}
+
+constexpr unsigned int atomix_legendre_size(unsigned int l_max) {
+    return atomix_legendre_idx(l_max + 1, 0);
+}
+
+void _a_assoc_legendre_p_all(unsigned int l_max, double x, double *out);
+
+inline void atomix_legendre_all(unsigned int l_max, double x, double *out) {
+    _a_assoc_legendre_p_all(l_max, x, out);
+}
+
+/* Batch variants evaluate `count` arguments for a fixed (n,m) or (l,m), vectorized with the
+   widest instruction set the running CPU supports (AVX-512, AVX2, or scalar fallback). */
+enum class SimdLevel { SCALAR = 0, AVX2 = 1, AVX512 = 2 };
+
+SimdLevel simd_level();
+const char* simd_level_name();
+
+void _a_poly_laguerre_batch(unsigned int n, double m, const double *x, double *out, size_t count);
+
+inline void atomix_laguerre_batch(unsigned int n, unsigned int m, const double *x, double *out, size_t count) {
+    _a_poly_laguerre_batch(n, m, x, out, count);
+}
+
+void _a_assoc_legendre_p_batch(unsigned int l, unsigned int m, const double *x, double *out, size_t count);
+
+inline void atomix_legendre_batch(unsigned int l, unsigned int m, const double *x, double *out, size_t count) {
+    _a_assoc_legendre_p_batch(l, m, x, out, count);
+}
+
 }}
 
 #endif
\ No newline at end of file
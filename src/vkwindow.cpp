@@ -53,6 +53,9 @@ void VKWindow::releaseWindow() {
 }
 
 void VKWindow::cleanup() {
+    if (cloudManager) {
+        cloudManager->cancel();
+    }
     if (cloudManager || waveManager) {
         fwModel->waitForFinished();
     }
@@ -63,8 +66,14 @@ void VKWindow::cleanup() {
 
 void VKWindow::changeModes(bool force) {
     if (!waveManager || force) {
+        if (cloudManager) {
+            cloudManager->cancel();
+            futureModel.waitForFinished();
+        }
         delete cloudManager;
         cloudManager = 0;
+        vw_bakePending = vw_cullPending = vw_bakeRunning = false;
+        vw_cloudFront.reset();
         flGraphState.clear(eCloudFlags);
     } else if (!cloudManager || force) {
         delete waveManager;
@@ -121,6 +130,21 @@ void VKWindow::initWindow() {
     this->vw_init = true;
 }
 
+/**
+ * @brief Queue a cloud config for the cloud manager.
+ *
+ * @details
+ * Requests are copied into a latest-wins queue instead of each starting its own thread:
+ * a generating request replaces any pending bake and cancels one in flight, and a slider
+ * request replaces any pending cull and carries its slider state into the pending bake.
+ * Rapid slider drags thus cost at most one cull in flight. A cull that has to wait for a
+ * running job is also applied to the last snapshot right away, if it can be (see
+ * CloudManager::cullSnapshot()), so the sliders stay live during a bake. See dispatchCloudJob().
+ *
+ * @param config The cloud config; copied, so the caller may keep editing it.
+ * @param cloudMap The orbital recipes; copied for generating requests only.
+ * @param generator True if this may generate a new cloud render, False if only culling.
+ */
 void VKWindow::newCloudConfig(AtomixCloudConfig *config, harmap *cloudMap, bool generator) {
     flGraphState.set(egs::CLOUD_MODE);
     if (flGraphState.hasAny(eWaveFlags)) {
@@ -129,14 +153,33 @@ void VKWindow::newCloudConfig(AtomixCloudConfig *config, harmap *cloudMap, bool
 
     if (!cloudManager) {
         cloudManager = new CloudManager();
+        cloudManager->setCacheDir(fileHandler->atomixFiles.cache());
+        cloudManager->setEstimator(&vw_estimator);
+        vw_estimator.setFile(fileHandler->atomixFiles.cache() + "bake.cal");
+        cloudManager->setDataFormat(vw_dataFormat);
+        cloudManager->setGatherStreams(vw_gather);
+        cloudManager->setToleranceIndex(vw_toleranceIndex);
         currentManager = cloudManager;
     }
 
-    futureModel = QtConcurrent::run(&CloudManager::receiveCloudMapAndConfig, cloudManager, config, cloudMap, generator);
-    fwModel->setFuture(futureModel);
-    this->max_n = cloudMap->rbegin()->first;
-    int divSciExp = std::abs(floor(log10(config->cloudTolerance)));
-    this->pConstCloud.maxRadius = cm_maxRadius[divSciExp - 1][max_n - 1];
+    if (generator) {
+        vw_bakeConfig = *config;
+        vw_bakeMap = *cloudMap;
+        vw_bakePending = true;
+        if (vw_bakeRunning) {
+            cloudManager->cancel();
+        }
+    } else {
+        vw_cullConfig = *config;
+        vw_cullPending = true;
+        vw_snapCullPending = true;
+        vw_bakeConfig.cloudCull_x = config->cloudCull_x;
+        vw_bakeConfig.cloudCull_y = config->cloudCull_y;
+        vw_bakeConfig.cloudCull_rIn = config->cloudCull_rIn;
+        vw_bakeConfig.cloudCull_rOut = config->cloudCull_rOut;
+    }
+
+    dispatchCloudJob();
     emit toggleLoading(true);
 }
 
@@ -377,12 +420,7 @@ void VKWindow::initWaveModel() {
 }
 
 void VKWindow::initCloudModel() {
-    // Define VBO:Vertex:GPU for Atomix Cloud
-    BufferCreateInfo cloudVert{};
-    cloudVert.binding = 0;
-    cloudVert.type = BufferType::VERTEX;
-    cloudVert.name = "cloudVertices";
-    cloudVert.dataTypes = { DataType::FLOAT_VEC4 };
+    // No VBO:Vertex:GPU -- gpu_harmonics.vert rebuilds each vertex from its index and the pConstCloud grid
 
     // Define VBO:Vertex:CPU for Atomix Cloud
     BufferCreateInfo cloudVertCPU{};
@@ -391,12 +429,13 @@ void VKWindow::initCloudModel() {
     cloudVertCPU.name = "cloudVerticesCPU";
     cloudVertCPU.dataTypes = { DataType::FLOAT_VEC4 };
 
-    // Define VBO:Data:GPU for Atomix Cloud
+    // Define VBO:Data:GPU for Atomix Cloud, in the order of CloudDataFormat
+    const std::array<DataType, 4> cloudDataTypes = { DataType::FLOAT, DataType::HALF, DataType::UNORM16, DataType::UNORM8 };
     BufferCreateInfo cloudData{};
     cloudData.binding = 1;
     cloudData.type = BufferType::DATA;
     cloudData.name = "cloudData";
-    cloudData.dataTypes = { DataType::FLOAT };
+    cloudData.dataTypes = { cloudDataTypes[static_cast<uint>(vw_dataFormat)] };
 
     // Define VBO:Data:CPU for Atomix Cloud
     BufferCreateInfo cloudDataCPU{};
@@ -405,45 +444,56 @@ void VKWindow::initCloudModel() {
     cloudDataCPU.name = "cloudDataCPU";
     cloudDataCPU.dataTypes = { DataType::FLOAT_VEC4 };
 
+    // Define VBO:Voxels:GPU for Atomix Cloud -- the visible voxel ids, for gathered streams drawn without indices
+    BufferCreateInfo cloudVoxels{};
+    cloudVoxels.binding = 1;
+    cloudVoxels.type = BufferType::VERTEX;
+    cloudVoxels.name = "cloudVoxels";
+    cloudVoxels.dataTypes = { DataType::UINT };
+
     // Define IBO for Atomix Cloud
     BufferCreateInfo cloudInd{};
     cloudInd.type = BufferType::INDEX;
     cloudInd.name = "cloudIndices";
     cloudInd.dataTypes = { DataType::UINT };
 
-    // Iff we are here from a mid-run resource reset, we can use the existing data
-    if (cloudManager) {
-        if (cloudManager->isCPU()) {
-            cloudVertCPU.count = cloudManager->getVertexCount();
-            cloudVertCPU.size = cloudManager->getVertexSize();
-            cloudVertCPU.data = cloudManager->getVertexData();
-            cloudDataCPU.count = cloudManager->getDataCount();
-            cloudDataCPU.size = cloudManager->getDataSize();
-            cloudDataCPU.data = cloudManager->getDataData();
+    // Iff we are here from a mid-run resource reset, we can use the last uploaded snapshot
+    if (cloudManager && vw_cloudFront) {
+        const ManagerSnapshot &front = *vw_cloudFront;
+        if (flGraphState.hasAny(egs::CPU_RENDER)) {
+            cloudVertCPU.count = front.vertexCount;
+            cloudVertCPU.size = front.vertexSize;
+            cloudVertCPU.data = front.vertexData.get();
+            cloudDataCPU.count = front.colourCount;
+            cloudDataCPU.size = front.colourSize;
+            cloudDataCPU.data = front.colourData.get();
+        } else {
+            cloudData.count = front.dataCount;
+            cloudData.size = front.dataSize;
+            cloudData.data = front.dataData.get();
+        }
+        cloudInd.count = front.indexCount;
+        cloudInd.size = front.indexSize;
+        if (vw_gather && flGraphState.hasNone(egs::CPU_RENDER)) {
+            cloudVoxels.count = cloudInd.count;
+            cloudVoxels.size = cloudInd.size;
+            cloudVoxels.data = front.indexData.get();
         } else {
-            cloudVert.count = cloudManager->getVertexCount();
-            cloudVert.size = cloudManager->getVertexSize();
-            cloudVert.data = cloudManager->getVertexData();
-            cloudData.count = cloudManager->getDataCount();
-            cloudData.size = cloudManager->getDataSize();
-            cloudData.data = cloudManager->getDataData();
+            cloudInd.data = front.indexData.get();
         }
-        cloudInd.count = cloudManager->getIndexCount();
-        cloudInd.size = cloudManager->getIndexSize();
-        cloudInd.data = cloudManager->getIndexData();
     }
 
     // Define Atomix Cloud Model with above buffers
     ModelCreateInfo cloudModel{};
     cloudModel.name = "cloud";
-    cloudModel.vbos = { &cloudVert, &cloudVertCPU, &cloudData, &cloudDataCPU };
+    cloudModel.vbos = { &cloudVertCPU, &cloudData, &cloudDataCPU, &cloudVoxels };
     cloudModel.ibo = &cloudInd;
     cloudModel.ubos = { "WorldState" };
-    cloudModel.vertShaders = { "gpu_harmonics.vert", "default.vert" };
+    cloudModel.vertShaders = { "gpu_harmonics.vert", "default.vert", "gpu_harmonics_gather.vert" };
     cloudModel.fragShaders = { "default.frag" };
     cloudModel.pushConstant = "pConstCloud";
     cloudModel.topologies = { VK_PRIMITIVE_TOPOLOGY_POINT_LIST };
-    cloudModel.bufferCombos = { { 0, 2 }, { 1, 3 } };
+    cloudModel.bufferCombos = { { 1 }, { 0, 2 }, { 1, 3 } };
     cloudModel.offsets = {
         {   .offset = 0,
             .vertShaderIndex = 0,
@@ -459,6 +509,15 @@ void VKWindow::initCloudModel() {
             .topologyIndex = 0,
             .bufferComboIndex = 1,
             .pushConstantIndex = -1
+        },
+        {
+            .offset = 0,
+            .vertShaderIndex = 2,
+            .fragShaderIndex = 0,
+            .topologyIndex = 0,
+            .bufferComboIndex = 2,
+            .pushConstantIndex = 0,
+            .indexed = false
         }
     };
     cloudModel.programs = {
@@ -467,6 +526,9 @@ void VKWindow::initCloudModel() {
         },
         { .name = "cpu",
           .offsets = { 1 }
+        },
+        { .name = "gather",
+          .offsets = { 2 }
         }
     };
 
@@ -677,10 +739,41 @@ void VKWindow::updateBuffersAndShaders() {
         currentManager->update(pConstWave.time);
         this->flGraphState.set(egs::UPDATE_REQUIRED);
     }
+
+    // Cloud results arrive as snapshots, which are uploaded even while the manager builds the next one
+    bool cloudSnapshots = (currentManager) && (currentManager == cloudManager);
+    if (cloudSnapshots) {
+        std::shared_ptr<const ManagerSnapshot> snap = cloudManager->takeSnapshot();
+        if (snap) {
+            vw_cloudFront = snap;
+            this->flGraphState.set(snap->flags | egs::UPDATE_REQUIRED);
+        }
+        // A cull still queued behind a job re-culls each new snapshot here, until the manager runs it
+        if (vw_cullPending && vw_cloudFront && (snap || vw_snapCullPending)) {
+            std::shared_ptr<const ManagerSnapshot> culled = CloudManager::cullSnapshot(*vw_cloudFront, vw_cullConfig);
+            if (culled) {
+                vw_cloudFront = culled;
+                uint flags = culled->flags;
+                if (this->flGraphState.hasAny(egs::UPD_IBO)) {
+                    flags &= ~uint(egs::UPD_IDXOFF);
+                }
+                this->flGraphState.set(flags | egs::UPDATE_REQUIRED);
+            }
+        }
+        vw_snapCullPending = false;
+        if (!threadsFinished) {
+            this->pollCloudProgress();
+        }
+    }
     
-    if (this->flGraphState.hasAny(egs::UPDATE_REQUIRED) && threadsFinished) {
-        // Capture updates from currentManager
-        this->flGraphState.set(currentManager->clearUpdates());
+    if (this->flGraphState.hasAny(egs::UPDATE_REQUIRED) && (threadsFinished || cloudSnapshots)) {
+        // Capture updates from currentManager, or from the snapshot it published
+        ManagerSnapshot live;
+        if (!cloudSnapshots) {
+            this->flGraphState.set(currentManager->clearUpdates());
+            live = currentManager->viewBuffers(flGraphState.intersection(eUpdateFlags));
+        }
+        const ManagerSnapshot &src = (cloudSnapshots && vw_cloudFront) ? *vw_cloudFront : live;
 
         // Set current model
         vw_previousModel = vw_currentModel;
@@ -699,6 +792,8 @@ void VKWindow::updateBuffersAndShaders() {
                 newProgram = "cpu";
             } else if (flGraphState.hasAny(egs::WAVE_MODE) && waveManager->getSphere()) {
                 newProgram = "sphere";
+            } else if (flGraphState.hasAny(egs::CLOUD_MODE) && vw_gather) {
+                newProgram = "gather";
             } else {
                 newProgram = "default";
             }
@@ -714,10 +809,10 @@ void VKWindow::updateBuffersAndShaders() {
             std::string bufferCPU = (flGraphState.hasAny(egs::CPU_RENDER)) ? "VerticesCPU" : "Vertices";
             updBuf.bufferName = vw_currentModel + bufferCPU;
             updBuf.type = BufferType::VERTEX;
-            updBuf.offset = currentManager->getVertexOffset();
-            updBuf.count = currentManager->getVertexCount();
-            updBuf.size = currentManager->getVertexSize();
-            updBuf.data = currentManager->getVertexData();
+            updBuf.offset = src.vertexOffset;
+            updBuf.count = src.vertexCount;
+            updBuf.size = src.vertexSize;
+            updBuf.data = src.vertexData.get();
             this->atomixProg->updateBuffer(updBuf);
         }
 
@@ -727,15 +822,15 @@ void VKWindow::updateBuffersAndShaders() {
             updBuf.bufferName = vw_currentModel + bufferCPU;
             updBuf.type = BufferType::DATA;
             if (flGraphState.hasAny(egs::CPU_RENDER)) {
-                updBuf.offset = currentManager->getColourOffset();
-                updBuf.count = currentManager->getColourCount();
-                updBuf.size = currentManager->getColourSize();
-                updBuf.data = currentManager->getColourData();
+                updBuf.offset = src.colourOffset;
+                updBuf.count = src.colourCount;
+                updBuf.size = src.colourSize;
+                updBuf.data = src.colourData.get();
             } else {
-                updBuf.offset = currentManager->getDataOffset();
-                updBuf.count = currentManager->getDataCount();
-                updBuf.size = currentManager->getDataSize();
-                updBuf.data = currentManager->getDataData();
+                updBuf.offset = src.dataOffset;
+                updBuf.count = src.dataCount;
+                updBuf.size = src.dataSize;
+                updBuf.data = src.dataData.get();
             }
             this->atomixProg->updateBuffer(updBuf);
         }
@@ -744,21 +839,36 @@ void VKWindow::updateBuffersAndShaders() {
         if (flGraphState.hasAny(egs::UPD_IBO | egs::UPD_IDXOFF)) {
             updBuf.bufferName = vw_currentModel + "Indices";
             updBuf.type = BufferType::INDEX;
-            updBuf.offset = currentManager->getIndexOffset();
-            updBuf.count = currentManager->getIndexCount();
-            updBuf.size = currentManager->getIndexSize();
+            updBuf.offset = src.indexOffset;
+            updBuf.count = src.indexCount;
+            updBuf.size = src.indexSize;
 
             if (updBuf.size) {
                 if (atomixProg->isSuspended(vw_currentModel)) {
                     atomixProg->resumeModel(vw_currentModel);
                 }
-                updBuf.data = (flGraphState.hasAny(egs::UPD_IDXOFF)) ? 0 : currentManager->getIndexData();
+                updBuf.data = (flGraphState.hasAny(egs::UPD_IDXOFF)) ? 0 : src.indexData.get();
+                if (vw_gather && flGraphState.hasAny(egs::CLOUD_MODE) && flGraphState.hasNone(egs::CPU_RENDER)) {
+                    // Gathered streams are drawn without indices: the visible voxel ids go to their own VBO, the IBO only keeps the count
+                    if (updBuf.data) {
+                        BufferUpdateInfo voxBuf = updBuf;
+                        voxBuf.bufferName = vw_currentModel + "Voxels";
+                        voxBuf.type = BufferType::VERTEX;
+                        this->atomixProg->updateBuffer(voxBuf);
+                    }
+                    updBuf.data = 0;
+                }
                 this->atomixProg->updateBuffer(updBuf);
             } else {
                 this->atomixProg->suspendModel(vw_currentModel);
             }
         }
 
+        // Update draw ranges: slider culling selects runs of the IBO instead of rebuilding it
+        if (flGraphState.hasAny(egs::UPD_RANGES) && src.drawRanges) {
+            this->atomixProg->updateDrawRanges(vw_currentModel, *src.drawRanges);
+        }
+
         // Update Uniforms
         if (flGraphState.hasAny(egs::UPD_UNI_MATHS | egs::UPD_UNI_COLOUR)) {
             if (flGraphState.hasAny(egs::UPD_UNI_MATHS)) {
@@ -774,7 +884,12 @@ void VKWindow::updateBuffersAndShaders() {
         }
 
         if (flGraphState.hasAny(egs::UPD_PUSH_CONST)) {
-            pConstWave.mode = waveManager->getMode();
+            if (flGraphState.hasAny(egs::CLOUD_MODE)) {
+                pConstCloud.resolution = src.gridResolution;
+                pConstCloud.divisor = src.gridDivisor;
+            } else {
+                pConstWave.mode = waveManager->getMode();
+            }
         }
 
         if (flGraphState.hasAny(egs::UPD_MATRICES)) {
@@ -790,6 +905,8 @@ void VKWindow::updateBuffersAndShaders() {
                 program = "cpu";
             } else if (flGraphState.hasAny(egs::WAVE_MODE) && waveManager->getSphere()) {
                 program = "sphere";
+            } else if (flGraphState.hasAny(egs::CLOUD_MODE) && vw_gather) {
+                program = "gather";
             } else {
                 program = "default";
             }
@@ -810,18 +927,137 @@ void VKWindow::setBGColour(float colour) {
     this->atomixProg->updateClearColor(vw_bg, vw_bg, vw_bg, 1.0f);
 }
 
-void VKWindow::estimateSize(AtomixCloudConfig *cfg, harmap *cloudMap, uint *vertex, uint *data, uint *index) {
-    uint layer_max = cloudManager->getMaxLayer(cfg->cloudTolerance, cloudMap->rbegin()->first, cfg->cloudLayDivisor);
-    uint pixel_count = (layer_max * cfg->cloudResolution * cfg->cloudResolution) >> 1;
+/**
+ * @brief Set the storage format of the GPU cloud PDV stream.
+ *
+ * @details
+ * Must be called before the cloud model is first created. Metal requires vertex strides to be
+ * multiples of 4 bytes, so macOS always uses FLOAT32.
+ *
+ * @param format The format to upload cloud PDVs in.
+ */
+void VKWindow::setCloudDataFormat(CloudDataFormat format) {
+    this->vw_dataFormat = (isMacOS) ? CloudDataFormat::FLOAT32 : format;
+}
+
+/**
+ * @brief Predict the peak memory and bake time of a cloud config, as this window would render it.
+ *
+ * @param cfg The cloud config.
+ * @param cloudMap The orbital recipes.
+ * @return The estimate from vw_estimator, calibrated by the bakes run so far.
+ */
+CloudEstimate VKWindow::estimateCloud(AtomixCloudConfig *cfg, harmap *cloudMap) {
+    return vw_estimator.estimate(*cfg, *cloudMap, vw_dataFormat, vw_gather);
+}
 
-    (*vertex) = (pixel_count << 2) * 3;     // (count)   * (3 floats) * (4 B/float) * (1 vector)  -- only allVertices
-    (*data) = pixel_count << 2;             // (count)   * (1 float)  * (4 B/float) * (1 vectors) -- only allData [already clear()ing dataStaging; might delete it]
-    (*index) = (pixel_count << 1) * 3;      // (count/2) * (1 uint)   * (4 B/uint)  * (3 vectors) -- idxTolerance + idxSlider + allIndices [very rough estimate]
+/**
+ * @brief Scale the grid of a cloud config to the largest that fits the budget set by setCloudBudget().
+ *
+ * @param[in,out] cfg The cloud config, whose resolution and divisor are replaced on success.
+ * @param cloudMap The orbital recipes.
+ * @return True if a grid fits, False if `cfg` was left unchanged.
+ */
+bool VKWindow::fitCloudBudget(AtomixCloudConfig *cfg, harmap *cloudMap) {
+    return vw_estimator.fitBudget(*cfg, *cloudMap, vw_dataFormat, vw_gather, vw_budgetHost, vw_budgetDevice);
 }
 
 void VKWindow::threadFinished() {
-    flGraphState.set(currentManager->clearUpdates() | egs::UPDATE_REQUIRED);
-    emit toggleLoading(false);
+    if (currentManager != cloudManager) {
+        flGraphState.set(currentManager->clearUpdates() | egs::UPDATE_REQUIRED);
+        emit toggleLoading(false);
+        return;
+    }
+
+    // Cloud results were published as a snapshot, so the next job can start before they are uploaded
+    dispatchCloudJob();
+    emit toggleLoading(!fwModel->isFinished());
+}
+
+/**
+ * @brief Start the next cloud job, if the manager is idle.
+ *
+ * @details
+ * A pending cull runs first, as it only re-culls the current cloud in milliseconds, unless
+ * no cloud was baked yet, or a bake is also pending and the current cloud has no
+ * tolerance-culled indices to cull. A pending bake runs next, and absorbs any cull still
+ * pending. The next pass of a progressive bake only runs with nothing else queued, as a
+ * pending bake supersedes it.
+ *
+ * A cull left waiting here was already applied to the last snapshot where possible, by
+ * updateBuffersAndShaders(), but still runs on the manager so its own buffers catch up.
+ *
+ * Jobs read owned copies of their config and map, which stay untouched until they finish.
+ * Each job publishes its results as a snapshot for the next frame to upload, so the next job
+ * may start right away.
+ */
+void VKWindow::dispatchCloudJob() {
+    if (!cloudManager || !fwModel->isFinished()) {
+        return;
+    }
+
+    if (vw_cullPending && !vw_jobMap.empty() && (!vw_bakePending || cloudManager->canCull())) {
+        vw_jobConfig = vw_cullConfig;
+        vw_cullPending = false;
+        vw_bakeRunning = false;
+        futureModel = QtConcurrent::run(&CloudManager::receiveCloudMapAndConfig, cloudManager, &vw_jobConfig, &vw_jobMap, false);
+    } else if (vw_bakePending) {
+        vw_jobConfig = vw_bakeConfig;
+        vw_jobMap = vw_bakeMap;
+        vw_bakePending = vw_cullPending = false;
+        vw_bakeRunning = true;
+        this->max_n = vw_jobMap.rbegin()->first;
+        this->pConstCloud.maxRadius = cloudManager->getMaxRadius(vw_jobConfig.cloudTolerance, max_n);
+        futureModel = QtConcurrent::run(&CloudManager::receiveCloudMapAndConfig, cloudManager, &vw_jobConfig, &vw_jobMap, true);
+    } else if (cloudManager->hasRefinement()) {
+        vw_bakeRunning = true;
+        futureModel = QtConcurrent::run(&CloudManager::refineCloud, cloudManager);
+    } else {
+        return;
+    }
+    fwModel->setFuture(futureModel);
+}
+
+/**
+ * @brief Report the running cloud job's progress and estimated time remaining.
+ *
+ * @details
+ * Called each frame while a cloud job runs, but only emits every PROGRESS_INTERVAL ms. The
+ * bar and ETA cover the whole job, across its stages and progressive passes, and the ETA
+ * uses an exponentially smoothed rate of job work units per ms, which only restarts with a
+ * new job. Between stages, or while no stage has a known total, the busy indicator shows.
+ */
+void VKWindow::pollCloudProgress() {
+    const int64_t PROGRESS_INTERVAL = 250;
+    BakeProgress progress = cloudManager->getProgress();
+    int64_t now = QDateTime::currentMSecsSinceEpoch();
+
+    if (progress.jobDone < vw_progressDone) {
+        vw_progressDone = progress.jobDone;
+        vw_progressTime = now;
+        vw_progressRate = 0.0;
+    } else if ((now - vw_progressTime) < PROGRESS_INTERVAL) {
+        return;
+    } else {
+        double rate = double(progress.jobDone - vw_progressDone) / double(now - vw_progressTime);
+        vw_progressRate = (vw_progressRate > 0.0) ? (0.7 * vw_progressRate + 0.3 * rate) : rate;
+        vw_progressDone = progress.jobDone;
+        vw_progressTime = now;
+    }
+
+    if ((progress.stage == BakeStage::IDLE) || !progress.total || !progress.jobTotal) {
+        emit progressChanged(0, 0, QString());
+        return;
+    }
+
+    static const char *stageNames[] = { "", "Creating", "Baking", "Culling", "Slicing" };
+    int permille = int((progress.jobDone * 1000) / progress.jobTotal);
+    QString text = QString("%1 %2%").arg(stageNames[uint(progress.stage)]).arg(permille / 10);
+    if (vw_progressRate > 0.0) {
+        int64_t eta = int64_t(double(progress.jobTotal - progress.jobDone) / vw_progressRate) / 1000;
+        text += QString("  ETA %1:%2").arg(eta / 60).arg(eta % 60, 2, 10, QChar('0'));
+    }
+    emit progressChanged(permille, 1000, text);
 }
 
 void VKWindow::threadFinishedWithResult(uint result) {
@@ -842,13 +1078,14 @@ void VKWindow::updateBufferSizes() {
     vw_info.data = 0;
     vw_info.index = 0;
 
-    if (flGraphState.hasAny(egs::WAVE_RENDER | egs::CLOUD_RENDER)) {
-        VSize = currentManager->getVertexSize();            // (count)   * (3 floats) * (4 B/float) * (1 vector)  -- only allVertices
-        ISize = currentManager->getIndexSize();         // (count/2) * (1 uint)   * (4 B/uint)  * (3 vectors) -- idxTolerance + idxSlider + allIndices [very rough estimate]}
-        if (flGraphState.hasAny(egs::CLOUD_RENDER)) {
-            DSize = currentManager->getDataSize();          // (count)   * (1 float)  * (4 B/float) * (1 vectors) -- only allData [already clear()ing dataStaging; might delete it]
-            ISize *= 3;
-        }
+    // Cloud sizes come from the uploaded snapshot, as the manager may already be building the next one
+    if (flGraphState.hasAny(egs::CLOUD_RENDER) && vw_cloudFront) {
+        VSize = vw_cloudFront->vertexSize;          // (count)   * (3 floats) * (4 B/float) * (1 vector)  -- only allVertices
+        ISize = vw_cloudFront->indexSize * 3;       // (count/2) * (1 uint)   * (4 B/uint)  * (3 vectors) -- idxTolerance + idxSlider + allIndices [very rough estimate]}
+        DSize = vw_cloudFront->dataSize;            // (count)   * (1 float)  * (4 B/float) * (1 vectors) -- only allData [already clear()ing dataStaging; might delete it]
+    } else if (flGraphState.hasAny(egs::WAVE_RENDER)) {
+        VSize = currentManager->getVertexSize();
+        ISize = currentManager->getIndexSize();
     }
 
     vw_info.vertex = VSize;
@@ -85,6 +85,8 @@ struct PushConstantsWave {
 
 struct PushConstantsCloud {
     float maxRadius = 0.0f;
+    uint resolution = 0;        // Grid the GPU shader rebuilds vertex positions from
+    uint divisor = 0;
 };
 
 enum egs {
@@ -105,6 +107,7 @@ enum egs {
     UPD_MATRICES =      1 << 14,    // Needs initVecsAndMatrices() to reset position and view
     CPU_RENDER =        1 << 15,    // Render on CPU
     UPDATE_REQUIRED =   1 << 16,    // An update must execute on next render
+    UPD_RANGES =        1 << 17,    // Cloud draw ranges into the IBO need to be updated
 };
 
 const uint eWaveFlags = egs::WAVE_MODE | egs::WAVE_RENDER;
@@ -169,7 +172,13 @@ public:
     void updateExtent(VkExtent2D &renderExtent);
     void updateBuffersAndShaders();
     void setBGColour(float colour);
-    void estimateSize(AtomixCloudConfig *cfg, harmap *cloudMap, uint *vertex, uint *data, uint *index);
+    void setCloudDataFormat(CloudDataFormat format);
+    void setCloudGather(bool enable) { this->vw_gather = enable; }
+    void setCloudToleranceIndex(bool enable) { this->vw_toleranceIndex = enable; }
+    void setCloudBudget(uint64_t hostBytes, uint64_t deviceBytes) { this->vw_budgetHost = hostBytes; this->vw_budgetDevice = deviceBytes; }
+    bool hasCloudBudget() { return (this->vw_budgetHost || this->vw_budgetDevice); }
+    CloudEstimate estimateCloud(AtomixCloudConfig *cfg, harmap *cloudMap);
+    bool fitCloudBudget(AtomixCloudConfig *cfg, harmap *cloudMap);
 
     void resetHang();
 
@@ -179,6 +188,7 @@ public:
 signals:
     void detailsChanged(AtomixInfo *info);
     void toggleLoading (bool loading);
+    void progressChanged(int value, int maximum, const QString &text);
     void forwardKeyEvent(QKeyEvent *e);
 
 public slots:
@@ -206,6 +216,8 @@ private:
 
     void threadFinished();
     void threadFinishedWithResult(uint result);
+    void dispatchCloudJob();
+    void pollCloudProgress();
     
     std::string withCommas(int64_t value);
     void updateBufferSizes();
@@ -229,6 +241,24 @@ private:
     QFutureWatcher<void> *fwModel;
     QFuture<void> futureModel;
 
+    // Cloud job queue -- only the newest pending bake and the newest pending cull are kept
+    AtomixCloudConfig vw_bakeConfig;
+    harmap vw_bakeMap;
+    AtomixCloudConfig vw_cullConfig;
+    AtomixCloudConfig vw_jobConfig;         // Owned copies read by the job in flight
+    harmap vw_jobMap;
+    bool vw_bakePending = false;
+    bool vw_cullPending = false;
+    bool vw_snapCullPending = false;        // vw_cullConfig not yet applied to vw_cloudFront
+    bool vw_bakeRunning = false;
+    std::shared_ptr<const ManagerSnapshot> vw_cloudFront;   // Cloud buffers last uploaded, kept for resource resets
+    CloudEstimator vw_estimator;                            // Outlives each cloudManager, so its calibration carries over
+    uint64_t vw_budgetHost = 0;
+    uint64_t vw_budgetDevice = 0;
+    uint64_t vw_progressDone = 0;
+    int64_t vw_progressTime = 0;
+    double vw_progressRate = 0.0;                           // Smoothed work units per ms of the current job
+
     glm::mat4 m4_rotation;
     glm::mat4 m4_translation;
     glm::vec3 v3_cameraPosition;
@@ -242,6 +272,9 @@ private:
     int64_t vw_timeEnd;
     int64_t vw_timePaused;
     float vw_bg = 0.0f;
+    CloudDataFormat vw_dataFormat = CloudDataFormat::FLOAT32;
+    bool vw_gather = false;
+    bool vw_toleranceIndex = false;
     
     VkExtent2D vw_extent = {0, 0};
     uint vw_movement = 0;